@@ -1,23 +1,67 @@
 #include "board.h"
 #include <algorithm>
-#include <iterator>
-#include <numeric>
+#include <bit>
+
+constexpr std::pair<int, int> neighborOffsets[] = {
+    {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}};
+
+// bit of an offset in a neighborhood() mask
+constexpr uint32_t neighborhoodBit(std::pair<int, int> offset)
+{
+    return (offset.second + 1) * 3 + offset.first + 1;
+}
 
 Board::Board(uint32_t width, uint32_t height)
-    : m_Data{width, height}, m_Cells(width * height, CellState::UNCLEARED)
+    : m_Data{width, height},
+      m_RowWords((width + 63) / 64),
+      m_Mines(m_RowWords * height),
+      m_Cleared(m_RowWords * height),
+      m_AdjacentMines(width * height),
+      m_NumRemainingSafe(width * height)
 {
 }
 
+void Board::addAdjacentMines(Point mine, int delta)
+{
+    for (auto offset : neighborOffsets)
+    {
+        Point pt{offset.first + mine.x, offset.second + mine.y};
+        if (pt.x >= width() || pt.y >= height())
+            continue;
+        m_AdjacentMines[pt.x + pt.y * width()] += delta;
+    }
+}
+
 void Board::genMines(uint32_t numMines, std::mt19937& gen)
 {
-    std::vector<uint32_t> nums(width() * height());
-    std::iota(nums.begin(), nums.end(), 0);
-    std::vector<uint32_t> result;
-    std::sample(nums.begin(), nums.end(), std::back_inserter(result), numMines, gen);
-
-    std::fill(m_Cells.begin(), m_Cells.end(), CellState::UNCLEARED);
-    for (uint32_t i : result)
-        m_Cells[i] = CellState::MINE;
+    // only the cells around the last game's mines have to be reset
+    for (uint32_t i : m_MineCells)
+    {
+        const Point mine{i % width(), i / width()};
+        m_Mines[bitIndex(mine) / 64] = 0;
+        addAdjacentMines(mine, -1);
+    }
+    m_MineCells.clear();
+    std::fill(m_Cleared.begin(), m_Cleared.end(), 0);
+    m_Revealed.clear();
+    m_NumCleared = 0;
+    m_NumRemainingSafe = width() * height() - numMines;
+    m_HitMine = false;
+
+    // Floyd's sampling: each step picks a cell from the first j + 1, and takes cell j instead if
+    // the pick is already a mine, which chooses every set of numMines cells with equal
+    // probability in numMines steps, using the mine plane as the set of picked cells
+    const uint32_t numCells = width() * height();
+    for (uint32_t j = numCells - numMines; j < numCells; j++)
+    {
+        uint32_t i = std::uniform_int_distribution<uint32_t>(0, j)(gen);
+        if (testBit(m_Mines, bitIndex({i % width(), i / width()})))
+            i = j;
+        const Point mine{i % width(), i / width()};
+        setBit(m_Mines, bitIndex(mine));
+        addAdjacentMines(mine, 1);
+        m_MineCells.push_back(i);
+    }
     m_Data.numMines = numMines;
 }
 
@@ -29,48 +73,93 @@ void Board::genMines(uint32_t numMines)
 
 MoveResult Board::makeMove(Point move)
 {
+    m_Revealed.clear();
     if (cell(move) == CellState::CLEARED)
         return MoveResult::ILLEGAL;
     if (cell(move) == CellState::MINE)
+    {
+        m_HitMine = true;
         return MoveResult::MINE;
+    }
 
     clearCells(move);
 
     return MoveResult::CLEAR;
 }
 
-constexpr std::pair<int, int> neighborOffsets[] = {
-    {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}};
-
-void Board::clearCells(Point location)
+uint32_t Board::neighborhood(const std::vector<uint64_t>& plane, Point pt) const
 {
-    if (cell(location) != CellState::UNCLEARED)
-        return;
+    const uint32_t w = pt.x / 64;
+    const uint32_t bit = pt.x % 64;
+    uint32_t result = 0;
+    for (uint32_t dy = 0; dy < 3; dy++)
+    {
+        // wraps around for the row above the first one
+        const uint32_t row = pt.y + dy - 1;
+        if (row >= height())
+            continue;
+        const uint64_t* words = &plane[row * m_RowWords];
+        // pt.x - 1, pt.x and pt.x + 1 in bits 0 to 2
+        uint64_t bits = (words[w] >> bit << 1) & 6;
+        if (bit == 63 && w + 1 < m_RowWords)
+            bits |= (words[w + 1] & 1) << 2;
+        if (bit > 0)
+            bits |= (words[w] >> (bit - 1)) & 1;
+        else if (w > 0)
+            bits |= words[w - 1] >> 63;
+        result |= bits << (3 * dy);
+    }
+    return result;
+}
 
-    m_Cells[location.x + width() * location.y] = CellState::CLEARED;
+std::span<const Point> Board::clearCells(Point location)
+{
+    const size_t first = m_Revealed.size();
+    setBit(m_Cleared, bitIndex(location));
+    m_Revealed.push_back(location);
 
-    bool hasAdjacentMine = false;
-    for (auto offset : neighborOffsets)
+    // the revealed cells double as the queue of the fill, and since cells are marked cleared
+    // as they are queued, each one is queued and looked at once
+    for (size_t head = first; head < m_Revealed.size(); head++)
     {
-        Point pt{offset.first + location.x, offset.second + location.y};
-        if (pt.x >= width() || pt.y >= height())
+        const Point curr = m_Revealed[head];
+        if (adjacentMines(curr) != 0)
             continue;
-        if (cell(pt) == CellState::MINE)
+
+        // none of the neighbors of a zero are mines
+        for (auto offset : neighborOffsets)
         {
-            hasAdjacentMine = true;
-            break;
+            Point pt{offset.first + curr.x, offset.second + curr.y};
+            if (pt.x >= width() || pt.y >= height())
+                continue;
+            const uint32_t idx = bitIndex(pt);
+            if (testBit(m_Cleared, idx))
+                continue;
+            setBit(m_Cleared, idx);
+            m_Revealed.push_back(pt);
         }
     }
-    if (hasAdjacentMine)
-        return;
+    const uint32_t numRevealed = m_Revealed.size() - first;
+    m_NumCleared += numRevealed;
+    m_NumRemainingSafe -= numRevealed;
+    return std::span<const Point>(m_Revealed).subspan(first);
+}
 
+CellInfo Board::cellInfo(Point location) const
+{
+    CellInfo cellInfo = {};
+    cellInfo.location = location;
+    cellInfo.adjacentMines = adjacentMines(location);
+    const uint32_t cleared = neighborhood(m_Cleared, location);
     for (auto offset : neighborOffsets)
     {
         Point pt{offset.first + location.x, offset.second + location.y};
         if (pt.x >= width() || pt.y >= height())
             continue;
-        clearCells(pt);
+        if (((cleared >> neighborhoodBit(offset)) & 1) == 0)
+            cellInfo.unclearedNeighbors.push_back(pt);
     }
+    return cellInfo;
 }
 
 BoardImage Board::genImage() const
@@ -78,26 +167,17 @@ BoardImage Board::genImage() const
     BoardImage result{m_Data};
     for (uint32_t y = 0; y < height(); y++)
     {
-        for (uint32_t x = 0; x < width(); x++)
+        for (uint32_t w = 0; w < m_RowWords; w++)
         {
-            if (cell({x, y}) != CellState::CLEARED)
-                continue;
-            CellInfo cellInfo = {};
-            cellInfo.location = {x, y};
-            for (auto offset : neighborOffsets)
+            for (uint64_t cleared = m_Cleared[y * m_RowWords + w]; cleared != 0;
+                cleared &= cleared - 1)
             {
-                Point pt{offset.first + x, offset.second + y};
-                if (pt.x >= width() || pt.y >= height())
-                    continue;
-                if (cell(pt) == CellState::MINE)
-                    cellInfo.adjacentMines++;
-                if (cell(pt) != CellState::CLEARED)
-                    cellInfo.unclearedNeighbors.push_back(pt);
+                const Point pt{w * 64 + static_cast<uint32_t>(std::countr_zero(cleared)), y};
+                if (adjacentMines(pt) == 0)
+                    result.addZeroCell(pt);
+                else
+                    result.addNumberedCell(cellInfo(pt));
             }
-            if (cellInfo.adjacentMines == 0)
-                result.addZeroCell(cellInfo.location);
-            else
-                result.addNumberedCell(cellInfo);
         }
     }
     return result;
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <ostream>
 #include <random>
+#include <span>
 #include <vector>
 
 enum class CellState : uint8_t
@@ -20,6 +21,13 @@ enum class MoveResult
     MINE
 };
 
+enum class GameStatus
+{
+    PLAYING,
+    WON,
+    LOST
+};
+
 class Board
 {
 public:
@@ -34,20 +42,73 @@ public:
     uint32_t height() const;
     uint32_t numMines() const;
     uint32_t numCleared() const;
+    // safe cells that are still uncleared
+    uint32_t numRemainingSafe() const;
+    uint32_t adjacentMines(Point pt) const;
+    // won once every safe cell is cleared, lost once a move hits a mine
+    GameStatus status() const;
+    // every safe cell is cleared, even if a move hit a mine before
+    bool isWon() const;
+    // cells cleared by the last call to makeMove
+    std::span<const Point> revealedCells() const;
+    // assumes the cell is cleared
+    CellInfo cellInfo(Point pt) const;
     BoardImage genImage() const;
 
 private:
-    void clearCells(Point location);
+    // clears location, which has to be uncleared and not a mine, and floods out from zeros
+    // returns the cells it cleared
+    std::span<const Point> clearCells(Point location);
+    // the 3x3 block of a bit plane around pt, row by row with bit 4 at pt
+    // cells outside of the board are 0
+    uint32_t neighborhood(const std::vector<uint64_t>& plane, Point pt) const;
+
+    static bool testBit(const std::vector<uint64_t>& plane, uint32_t idx);
+    static void setBit(std::vector<uint64_t>& plane, uint32_t idx);
+    uint32_t bitIndex(Point pt) const;
+    void addAdjacentMines(Point mine, int delta);
 
     BoardData m_Data;
-    std::vector<CellState> m_Cells;
+    // Each cell state is a bit plane with every row packed into m_RowWords 64 bit words,
+    // and the bits past the end of a row always 0, so the cells of a state can be scanned
+    // a word at a time. Cleared cells are never mines
+    uint32_t m_RowWords;
+    std::vector<uint64_t> m_Mines;
+    std::vector<uint64_t> m_Cleared;
+    // number of mines next to each cell, at x + y * width
+    // computed once by genMines, since the mines never move
+    std::vector<uint8_t> m_AdjacentMines;
+    // cell indices of the mines, so the next genMines only resets the cells around them
+    std::vector<uint32_t> m_MineCells;
+    std::vector<Point> m_Revealed;
+    uint32_t m_NumCleared = 0;
+    uint32_t m_NumRemainingSafe;
+    bool m_HitMine = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const Board& board);
 
+inline uint32_t Board::bitIndex(Point pt) const
+{
+    return pt.y * m_RowWords * 64 + pt.x;
+}
+
+inline bool Board::testBit(const std::vector<uint64_t>& plane, uint32_t idx)
+{
+    return (plane[idx / 64] >> (idx % 64)) & 1;
+}
+
+inline void Board::setBit(std::vector<uint64_t>& plane, uint32_t idx)
+{
+    plane[idx / 64] |= 1ull << (idx % 64);
+}
+
 inline CellState Board::cell(Point pt) const
 {
-    return m_Cells[pt.x + pt.y * width()];
+    const uint32_t idx = bitIndex(pt);
+    if (testBit(m_Mines, idx))
+        return CellState::MINE;
+    return testBit(m_Cleared, idx) ? CellState::CLEARED : CellState::UNCLEARED;
 }
 
 inline uint32_t Board::width() const
@@ -65,15 +126,34 @@ inline uint32_t Board::numMines() const
     return m_Data.numMines;
 }
 
+inline uint32_t Board::adjacentMines(Point pt) const
+{
+    return m_AdjacentMines[pt.x + pt.y * width()];
+}
+
+inline std::span<const Point> Board::revealedCells() const
+{
+    return m_Revealed;
+}
+
 inline uint32_t Board::numCleared() const
 {
-    uint32_t count = 0;
-    for (uint32_t y = 0; y < height(); y++)
-    {
-        for (uint32_t x = 0; x < width(); x++)
-        {
-            count += cell({x, y}) == CellState::CLEARED;
-        }
-    }
-    return count;
+    return m_NumCleared;
+}
+
+inline uint32_t Board::numRemainingSafe() const
+{
+    return m_NumRemainingSafe;
+}
+
+inline GameStatus Board::status() const
+{
+    if (m_HitMine)
+        return GameStatus::LOST;
+    return m_NumRemainingSafe == 0 ? GameStatus::WON : GameStatus::PLAYING;
+}
+
+inline bool Board::isWon() const
+{
+    return m_NumRemainingSafe == 0;
 }
@@ -1,11 +1,18 @@
 #include "board.h"
+#include "solvers/anytime.h"
+#include "solvers/backtracking.h"
 #include "solvers/basic_optimized.h"
 #include "solvers/brute_force.h"
+#include "solvers/frontier_dp.h"
+#include "solvers/model_counting.h"
+#include "solvers/sampling.h"
+#include "solvers/solver_session.h"
 #include "test_suite.h"
 #include "test_suite_gen.h"
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 
 void tryRenderSolution(const BoardImage& image)
@@ -16,6 +23,9 @@ void tryRenderSolution(const BoardImage& image)
         std::cout << "No solution available" << std::endl;
 }
 
+// positions with components too large to enumerate are solved approximately within this budget
+constexpr auto MOVE_BUDGET = std::chrono::milliseconds(50);
+
 enum class GameResult
 {
     WIN,
@@ -39,10 +49,22 @@ GameResult simulateGameDeterministic(uint32_t width, uint32_t height, uint32_t n
         moveResult = board.makeMove(Point{distW(gen), distH(gen)});
     } while (moveResult == MoveResult::MINE);
 
-    while (board.numCleared() < board.width() * board.height() - board.numMines())
+    // only the components around the cells each move reveals are solved again
+    solvers::SolverSession session({width, height, numMines});
+    const auto revealMove = [&]()
     {
-        BoardImage image = board.genImage();
-        auto solution = solvers::basic_optimized::solve(image);
+        std::vector<CellInfo> revealed;
+        for (Point pt : board.revealedCells())
+            revealed.push_back(board.cellInfo(pt));
+        session.reveal(revealed);
+    };
+    revealMove();
+
+    while (board.numRemainingSafe() > 0)
+    {
+        auto solution = session.solve();
+        if (!solution.has_value())
+            solution = solvers::anytime::solveWithin(board.genImage(), MOVE_BUDGET);
         if (!solution.has_value())
             return GameResult::TOO_COMPLEX;
         if (solution->clears.empty())
@@ -53,13 +75,15 @@ GameResult simulateGameDeterministic(uint32_t width, uint32_t height, uint32_t n
             MoveResult moveResult = board.makeMove(clear);
             if (moveResult == MoveResult::MINE)
                 return GameResult::LOSS;
+            revealMove();
         }
     }
 
     return GameResult::WIN;
 }
 
-GameResult simulateGameProbabilistic(uint32_t width, uint32_t height, uint32_t numMines)
+GameResult simulateGameProbabilistic(uint32_t width, uint32_t height, uint32_t numMines,
+    solvers::component_cache::ComponentCache& cache)
 {
     static std::random_device rd;
     static std::mt19937 gen{rd()};
@@ -74,10 +98,12 @@ GameResult simulateGameProbabilistic(uint32_t width, uint32_t height, uint32_t n
         moveResult = board.makeMove(Point{distW(gen), distH(gen)});
     } while (moveResult == MoveResult::MINE);
 
-    while (board.numCleared() < board.width() * board.height() - board.numMines())
+    while (board.numRemainingSafe() > 0)
     {
         BoardImage image = board.genImage();
-        auto solution = solvers::basic_optimized::solve(image);
+        auto solution = solvers::basic_optimized::solveCached(image, cache);
+        if (!solution.has_value())
+            solution = solvers::anytime::solveWithin(image, MOVE_BUDGET);
         if (!solution.has_value())
             return GameResult::TOO_COMPLEX;
         if (solution->clears.empty())
@@ -111,9 +137,13 @@ GameResult simulateGameProbabilistic(uint32_t width, uint32_t height, uint32_t n
                         outsidePoints.push_back(point);
                     }
                 }
-                std::uniform_int_distribution<int> dist(0, outsidePoints.size() - 1);
-                int idx = dist(gen);
-                bestPoint = outsidePoints[idx];
+                // outsideMineProb is 0 when every uncleared cell is on the frontier
+                if (!outsidePoints.empty())
+                {
+                    std::uniform_int_distribution<int> dist(0, outsidePoints.size() - 1);
+                    int idx = dist(gen);
+                    bestPoint = outsidePoints[idx];
+                }
             }
 
             MoveResult moveResult = board.makeMove(bestPoint);
@@ -164,15 +194,119 @@ void simulateGamesDeterministic(uint32_t width, uint32_t height, uint32_t numMin
 void simulateGamesProbabilistic(uint32_t width, uint32_t height, uint32_t numMines, uint32_t games = 100)
 {
     std::array<uint32_t, 4> results = {};
+    // the same small components show up over and over across games
+    solvers::component_cache::ComponentCache cache;
     for (uint32_t simul = 0; simul < games; simul++)
     {
-        GameResult result = simulateGameProbabilistic(width, height, numMines);
+        GameResult result = simulateGameProbabilistic(width, height, numMines, cache);
         results[static_cast<uint32_t>(result)]++;
     }
     std::cout << "WIDTH: " << width << " HEIGHT: " << height << " MINES: " << numMines
               << " SOLVED: " << toPercentStats(results[0], games)
               << " LOSS: " << toPercentStats(results[1], games)
               << " TOO_COMPLEX: " << toPercentStats(results[2], games) << std::endl;
+    std::cout << "Component cache: " << cache.hits() << "/" << cache.lookups() << " hits ("
+              << cache.hitRate() * 100 << "%)" << std::endl;
+}
+
+void benchmarkConstraintKernels(TestSuite suite, uint32_t iterations = 100)
+{
+    using solvers::constraint_kernels::Kernel;
+    const auto report = [&](const char* name, Solver solver)
+    {
+        double seconds = benchmark_test_suite(suite, solver, iterations);
+        std::cout << name << " kernel: " << seconds * 1000 << " ms per suite" << std::endl;
+    };
+
+    report("scalar", [](const BoardImage& image)
+        {
+            return solvers::basic_optimized::solveWithKernel<Kernel::SCALAR>(image);
+        });
+#if defined(__AVX2__)
+    report("AVX2", [](const BoardImage& image)
+        {
+            return solvers::basic_optimized::solveWithKernel<Kernel::AVX2>(image);
+        });
+#endif
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+    report("AVX-512", [](const BoardImage& image)
+        {
+            return solvers::basic_optimized::solveWithKernel<Kernel::AVX512>(image);
+        });
+#endif
+}
+
+void reportVisitedConfigurations(TestSuite suite)
+{
+    using solvers::basic_optimized::Ordering;
+    const auto report = [&](const char* name, Ordering ordering)
+    {
+        solvers::basic_optimized::Statistics statistics;
+        benchmark_test_suite(suite,
+            [&](const BoardImage& image)
+            {
+                return solvers::basic_optimized::solveWithKernel<
+                    solvers::constraint_kernels::DEFAULT_KERNEL>(image, 1, ordering, &statistics);
+            },
+            1);
+        std::cout << name << " ordering: " << statistics.visitedConfigurations
+                  << " configurations visited" << std::endl;
+    };
+
+    report("frontier", Ordering::FRONTIER);
+    report("reverse Cuthill-McKee", Ordering::REVERSE_CUTHILL_MCKEE);
+}
+
+// the first pass grows the context's buffer, every pass after that should stay off the heap
+void reportContextAllocations(TestSuite suite, uint32_t passes = 3)
+{
+    const std::vector<BoardImage> images = buildTestSuiteImages(suite);
+    std::vector<SolutionInfo> solutions(images.size());
+    solvers::SolverContext context;
+    for (uint32_t pass = 0; pass < passes; pass++)
+    {
+        const uint64_t before = context.heapAllocations();
+        for (size_t i = 0; i < images.size(); i++)
+            solvers::basic_optimized::solveInContext(images[i], context, solutions[i]);
+        std::cout << "Pass " << pass << ": " << context.heapAllocations() - before
+                  << " heap allocations, " << context.bufferSize() << " byte buffer" << std::endl;
+    }
+}
+
+void reportSamplingAccuracy(TestSuite suite)
+{
+    double maxError = 0.0;
+    double maxEstimatedError = 0.0;
+    double maxRHat = 0.0;
+    benchmark_test_suite(suite,
+        [&](const BoardImage& image)
+        {
+            auto exact = solvers::basic_optimized::solve(image);
+            solvers::sampling::Diagnostics diagnostics;
+            auto sampled = solvers::sampling::solve(image, {}, &diagnostics);
+
+            std::unordered_map<Point, double, PointHash> sampledProbs;
+            for (const auto& mineProb : sampled->mineProbs)
+                sampledProbs.insert({mineProb.point, mineProb.prob});
+            for (Point mine : exact->mines)
+                sampledProbs.insert({mine, 1.0});
+            for (Point clear : exact->clears)
+                sampledProbs.insert({clear, 0.0});
+            for (const auto& mineProb : exact->mineProbs)
+            {
+                double error = std::abs(sampledProbs[mineProb.point] - mineProb.prob);
+                maxError = std::max(maxError, error);
+            }
+            double outsideError = std::abs(sampled->outsideMineProb - exact->outsideMineProb);
+            maxError = std::max(maxError, outsideError);
+
+            maxEstimatedError = std::max(maxEstimatedError, sampled->probError);
+            maxRHat = std::max(maxRHat, diagnostics.maxRHat);
+            return exact;
+        },
+        1);
+    std::cout << "Sampling: max error " << maxError << ", max estimated error "
+              << maxEstimatedError << ", max R-hat " << maxRHat << std::endl;
 }
 
 int main()
@@ -230,9 +364,40 @@ int main()
     run_test_suite(TestSuite::MEDIUM, solvers::basic_optimized::solve);
     run_test_suite(TestSuite::HARD, solvers::basic_optimized::solve);
 
+    // run_test_suite(TestSuite::EASY, solvers::basic_optimized::ReusableSolver());
+    // run_test_suite(TestSuite::MEDIUM, solvers::basic_optimized::ReusableSolver());
+    // run_test_suite(TestSuite::HARD, solvers::basic_optimized::ReusableSolver());
+
     // run_test_suite(TestSuite::EASY, solvers::brute_force::solve);
     // run_test_suite(TestSuite::MEDIUM, solvers::brute_force::solve);
     // run_test_suite(TestSuite::HARD, solvers::brute_force::solve);
 
+    // benchmarkConstraintKernels(TestSuite::MEDIUM);
+    // benchmarkConstraintKernels(TestSuite::HARD);
+
+    // reportVisitedConfigurations(TestSuite::EASY);
+    // reportVisitedConfigurations(TestSuite::MEDIUM);
+    // reportVisitedConfigurations(TestSuite::HARD);
+
+    // reportSamplingAccuracy(TestSuite::EASY);
+    // reportSamplingAccuracy(TestSuite::MEDIUM);
+    // reportSamplingAccuracy(TestSuite::HARD);
+
+    // reportContextAllocations(TestSuite::EASY);
+    // reportContextAllocations(TestSuite::MEDIUM);
+    // reportContextAllocations(TestSuite::HARD);
+
+    // run_test_suite(TestSuite::EASY, solvers::backtracking::solve);
+    // run_test_suite(TestSuite::MEDIUM, solvers::backtracking::solve);
+    // run_test_suite(TestSuite::HARD, solvers::backtracking::solve);
+
+    // run_test_suite(TestSuite::EASY, solvers::frontier_dp::solve);
+    // run_test_suite(TestSuite::MEDIUM, solvers::frontier_dp::solve);
+    // run_test_suite(TestSuite::HARD, solvers::frontier_dp::solve);
+
+    // run_test_suite(TestSuite::EASY, solvers::model_counting::solve);
+    // run_test_suite(TestSuite::MEDIUM, solvers::model_counting::solve);
+    // run_test_suite(TestSuite::HARD, solvers::model_counting::solve);
+
     return 0;
 }
@@ -794,6 +794,18 @@ inline std::vector<TestPosition> easyCases = {
             712,
             {{{6, 0}, 0.500000}, {{6, 1}, 0.500000}, {{13, 4}, 0.500000}, {{14, 4}, 0.500000}, {{8, 7}, 0.216540}, {{8, 8}, 0.216540}, {{8, 9}, 0.216540}, {{9, 9}, 0.216540}, {{10, 9}, 0.305766}, {{10, 8}, 0.305766}, {{10, 7}, 0.305766}, {{9, 7}, 0.216540}, {{11, 9}, 0.216540}, {{12, 9}, 0.216540}, {{12, 8}, 0.216540}, {{12, 7}, 0.216540}, {{11, 7}, 0.216540}}
         }
+    },
+    // a numbered cell with no uncleared neighbors left that still needs a mine, so no
+    // configuration is valid even though the mine total fits in the uncleared cells
+    {
+        {5, 1, 1},
+        {{{1, 0}, 0}, {{0, 0}, 1}},
+        {
+            {},
+            {},
+            0,
+            {}
+        }
     }
 };
 
@@ -805,7 +817,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{3, 11}, {5, 11}, {1, 11}, {7, 12}, {0, 11}, {7, 11}, {2, 12}, {11, 12}},
             {{4, 11}, {6, 11}, {14, 12}, {12, 12}, {13, 12}, {2, 11}, {11, 11}},
             34272,
-            {{{2, 5}, 0.103065}, {{2, 6}, 0.103065}, {{2, 7}, 0.103065}, {{3, 7}, 0.190804}, {{4, 7}, 0.190804}, {{4, 6}, 0.103065}, {{4, 5}, 0.103065}, {{3, 5}, 0.103065}, {{3, 8}, 0.269732}, {{3, 9}, 0.269732}, {{4, 9}, 0.269732}, {{5, 9}, 0.269732}, {{5, 8}, 0.269732}, {{5, 7}, 0.269732}, {{11, 7}, 0.375000}, {{11, 8}, 0.375000}, {{11, 9}, 0.375000}, {{12, 9}, 0.375000}, {{13, 9}, 0.375000}, {{13, 8}, 0.375000}, {{13, 7}, 0.375000}, {{12, 7}, 0.375000}, {{7, 10}, 0.149224}, {{9, 10}, 0.701553}, {{8, 10}, 0.149224}, {{10, 10}, 0.149224}, {{11, 10}, 0.149224}, {{14, 14}, 0.500000}, {{14, 13}, 0.000000}}
+            {{{2, 5}, 0.103065}, {{2, 6}, 0.103065}, {{2, 7}, 0.103065}, {{3, 7}, 0.190804}, {{4, 7}, 0.190804}, {{4, 6}, 0.103065}, {{4, 5}, 0.103065}, {{3, 5}, 0.103065}, {{3, 8}, 0.269732}, {{3, 9}, 0.269732}, {{4, 9}, 0.269732}, {{5, 9}, 0.269732}, {{5, 8}, 0.269732}, {{5, 7}, 0.269732}, {{11, 7}, 0.375000}, {{11, 8}, 0.375000}, {{11, 9}, 0.375000}, {{12, 9}, 0.375000}, {{13, 9}, 0.375000}, {{13, 8}, 0.375000}, {{13, 7}, 0.375000}, {{12, 7}, 0.375000}, {{7, 10}, 0.149224}, {{9, 10}, 0.701553}, {{8, 10}, 0.149224}, {{10, 10}, 0.149224}, {{11, 10}, 0.149224}, {{14, 14}, 0.500000}, {{14, 13}, 0.500000}}
         }
     },
     {
@@ -815,7 +827,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{12, 3}, {12, 1}},
             {{12, 2}, {12, 4}, {12, 0}},
             35840,
-            {{{13, 4}, 0.500000}, {{14, 4}, 0.500000}, {{0, 0}, 0.125000}, {{0, 1}, 0.125000}, {{0, 2}, 0.125000}, {{1, 2}, 0.125000}, {{2, 2}, 0.125000}, {{2, 1}, 0.125000}, {{2, 0}, 0.125000}, {{1, 0}, 0.125000}, {{12, 5}, 0.125000}, {{12, 6}, 0.125000}, {{12, 7}, 0.125000}, {{13, 7}, 0.125000}, {{14, 7}, 0.125000}, {{14, 6}, 0.125000}, {{14, 5}, 0.125000}, {{13, 5}, 0.125000}, {{2, 8}, 0.250000}, {{2, 9}, 0.250000}, {{2, 10}, 0.250000}, {{3, 10}, 0.250000}, {{4, 10}, 0.250000}, {{4, 9}, 0.250000}, {{4, 8}, 0.250000}, {{3, 8}, 0.250000}, {{6, 13}, 0.400000}, {{6, 14}, 0.000000}, {{8, 14}, 0.000000}, {{8, 13}, 0.000000}, {{7, 13}, 0.000000}}
+            {{{13, 4}, 0.500000}, {{14, 4}, 0.500000}, {{0, 0}, 0.125000}, {{0, 1}, 0.125000}, {{0, 2}, 0.125000}, {{1, 2}, 0.125000}, {{2, 2}, 0.125000}, {{2, 1}, 0.125000}, {{2, 0}, 0.125000}, {{1, 0}, 0.125000}, {{12, 5}, 0.125000}, {{12, 6}, 0.125000}, {{12, 7}, 0.125000}, {{13, 7}, 0.125000}, {{14, 7}, 0.125000}, {{14, 6}, 0.125000}, {{14, 5}, 0.125000}, {{13, 5}, 0.125000}, {{2, 8}, 0.250000}, {{2, 9}, 0.250000}, {{2, 10}, 0.250000}, {{3, 10}, 0.250000}, {{4, 10}, 0.250000}, {{4, 9}, 0.250000}, {{4, 8}, 0.250000}, {{3, 8}, 0.250000}, {{6, 13}, 0.400000}, {{6, 14}, 0.400000}, {{8, 14}, 0.400000}, {{8, 13}, 0.400000}, {{7, 13}, 0.400000}}
         }
     },
     {
@@ -825,7 +837,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{7, 5}, {8, 2}, {7, 7}, {2, 0}, {6, 9}, {2, 5}, {7, 3}, {6, 3}, {2, 7}, {2, 11}},
             {{7, 6}, {7, 4}, {7, 9}, {2, 6}, {1, 7}, {6, 10}, {6, 11}, {1, 11}},
             14580,
-            {{{1, 3}, 0.333333}, {{1, 4}, 0.333333}, {{1, 5}, 0.333333}, {{8, 1}, 0.828645}, {{8, 0}, 0.171355}, {{1, 0}, 0.333333}, {{1, 1}, 0.333333}, {{1, 2}, 0.333333}, {{8, 3}, 0.171355}, {{13, 3}, 0.400000}, {{13, 4}, 0.400000}, {{13, 5}, 0.400000}, {{14, 5}, 0.400000}, {{14, 3}, 0.400000}, {{0, 7}, 0.147059}, {{0, 8}, 0.147059}, {{0, 9}, 0.705882}, {{8, 9}, 0.333333}, {{8, 8}, 0.333333}, {{8, 7}, 0.333333}, {{0, 10}, 0.147059}, {{0, 11}, 0.147059}, {{2, 12}, 0.222222}, {{3, 12}, 0.222222}, {{4, 12}, 0.555556}, {{5, 12}, 0.222222}, {{6, 12}, 0.000000}, {{1, 12}, 0.000000}, {{1, 13}, 0.000000}, {{1, 14}, 0.000000}, {{2, 14}, 0.000000}, {{3, 14}, 0.000000}, {{3, 13}, 0.000000}}
+            {{{1, 3}, 0.333333}, {{1, 4}, 0.333333}, {{1, 5}, 0.333333}, {{8, 1}, 0.828645}, {{8, 0}, 0.171355}, {{1, 0}, 0.333333}, {{1, 1}, 0.333333}, {{1, 2}, 0.333333}, {{8, 3}, 0.171355}, {{13, 3}, 0.400000}, {{13, 4}, 0.400000}, {{13, 5}, 0.400000}, {{14, 5}, 0.400000}, {{14, 3}, 0.400000}, {{0, 7}, 0.147059}, {{0, 8}, 0.147059}, {{0, 9}, 0.705882}, {{8, 9}, 0.333333}, {{8, 8}, 0.333333}, {{8, 7}, 0.333333}, {{0, 10}, 0.147059}, {{0, 11}, 0.147059}, {{2, 12}, 0.222222}, {{3, 12}, 0.222222}, {{4, 12}, 0.555556}, {{5, 12}, 0.222222}, {{6, 12}, 0.222222}, {{1, 12}, 0.259259}, {{1, 13}, 0.259259}, {{1, 14}, 0.259259}, {{2, 14}, 0.259259}, {{3, 14}, 0.259259}, {{3, 13}, 0.259259}}
         }
     },
     {
@@ -835,7 +847,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{13, 10}, {14, 10}, {11, 13}},
             {{11, 12}, {11, 10}, {11, 11}, {12, 10}, {11, 14}},
             56960,
-            {{{0, 7}, 0.125000}, {{0, 8}, 0.125000}, {{0, 9}, 0.125000}, {{1, 9}, 0.125000}, {{2, 9}, 0.125000}, {{2, 8}, 0.125000}, {{2, 7}, 0.125000}, {{1, 7}, 0.125000}, {{12, 0}, 0.200000}, {{12, 1}, 0.200000}, {{13, 1}, 0.200000}, {{14, 1}, 0.200000}, {{14, 0}, 0.200000}, {{7, 9}, 0.218357}, {{7, 10}, 0.218357}, {{7, 11}, 0.302738}, {{8, 11}, 0.302738}, {{9, 11}, 0.302738}, {{9, 10}, 0.218357}, {{9, 9}, 0.218357}, {{8, 9}, 0.218357}, {{2, 11}, 0.125000}, {{2, 12}, 0.125000}, {{2, 13}, 0.125000}, {{3, 13}, 0.125000}, {{4, 13}, 0.125000}, {{4, 12}, 0.125000}, {{4, 11}, 0.125000}, {{3, 11}, 0.125000}, {{7, 12}, 0.218357}, {{7, 13}, 0.218357}, {{8, 13}, 0.218357}, {{9, 13}, 0.000000}, {{9, 12}, 0.000000}}
+            {{{0, 7}, 0.125000}, {{0, 8}, 0.125000}, {{0, 9}, 0.125000}, {{1, 9}, 0.125000}, {{2, 9}, 0.125000}, {{2, 8}, 0.125000}, {{2, 7}, 0.125000}, {{1, 7}, 0.125000}, {{12, 0}, 0.200000}, {{12, 1}, 0.200000}, {{13, 1}, 0.200000}, {{14, 1}, 0.200000}, {{14, 0}, 0.200000}, {{7, 9}, 0.218357}, {{7, 10}, 0.218357}, {{7, 11}, 0.302738}, {{8, 11}, 0.302738}, {{9, 11}, 0.302738}, {{9, 10}, 0.218357}, {{9, 9}, 0.218357}, {{8, 9}, 0.218357}, {{2, 11}, 0.125000}, {{2, 12}, 0.125000}, {{2, 13}, 0.125000}, {{3, 13}, 0.125000}, {{4, 13}, 0.125000}, {{4, 12}, 0.125000}, {{4, 11}, 0.125000}, {{3, 11}, 0.125000}, {{7, 12}, 0.218357}, {{7, 13}, 0.218357}, {{8, 13}, 0.218357}, {{9, 13}, 0.218357}, {{9, 12}, 0.218357}}
         }
     },
     {
@@ -845,7 +857,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{0, 4}, {0, 7}, {8, 1}, {8, 3}, {0, 1}, {3, 10}, {0, 12}, {7, 4}, {3, 0}, {5, 4}, {5, 7}},
             {{0, 3}, {0, 5}, {0, 6}, {8, 0}, {8, 2}, {8, 4}, {0, 0}, {0, 2}, {0, 8}, {0, 9}, {0, 10}, {1, 12}, {2, 12}, {3, 12}, {5, 6}, {1, 0}, {6, 4}, {5, 5}, {5, 8}, {5, 9}},
             11424,
-            {{{9, 9}, 0.171315}, {{9, 10}, 0.171315}, {{9, 11}, 0.276228}, {{10, 11}, 0.276228}, {{11, 11}, 0.276228}, {{11, 10}, 0.276228}, {{11, 9}, 0.276228}, {{10, 9}, 0.276228}, {{10, 12}, 0.250000}, {{10, 13}, 0.250000}, {{10, 14}, 0.250000}, {{11, 14}, 0.250000}, {{12, 14}, 0.250000}, {{12, 13}, 0.250000}, {{12, 12}, 0.250000}, {{11, 12}, 0.250000}, {{7, 8}, 0.109562}, {{7, 9}, 0.109562}, {{7, 10}, 0.000000}, {{8, 10}, 0.000000}, {{9, 8}, 0.000000}, {{8, 8}, 0.000000}, {{1, 10}, 0.000000}, {{2, 10}, 0.000000}, {{4, 10}, 0.000000}, {{5, 10}, 0.000000}, {{3, 14}, 0.000000}, {{3, 13}, 0.000000}}
+            {{{9, 9}, 0.171315}, {{9, 10}, 0.171315}, {{9, 11}, 0.276228}, {{10, 11}, 0.276228}, {{11, 11}, 0.276228}, {{11, 10}, 0.276228}, {{11, 9}, 0.276228}, {{10, 9}, 0.276228}, {{10, 12}, 0.250000}, {{10, 13}, 0.250000}, {{10, 14}, 0.250000}, {{11, 14}, 0.250000}, {{12, 14}, 0.250000}, {{12, 13}, 0.250000}, {{12, 12}, 0.250000}, {{11, 12}, 0.250000}, {{7, 8}, 0.109562}, {{7, 9}, 0.109562}, {{7, 10}, 0.109562}, {{8, 10}, 0.109562}, {{9, 8}, 0.109562}, {{8, 8}, 0.109562}, {{1, 10}, 0.500000}, {{2, 10}, 0.500000}, {{4, 10}, 0.500000}, {{5, 10}, 0.500000}, {{3, 14}, 0.500000}, {{3, 13}, 0.500000}}
         }
     },
     {
@@ -855,7 +867,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{1, 9}},
             {{1, 6}, {4, 9}},
             26928,
-            {{{1, 5}, 0.227161}, {{1, 7}, 0.832204}, {{3, 5}, 0.325961}, {{2, 5}, 0.614675}, {{5, 7}, 0.504425}, {{5, 6}, 0.072061}, {{5, 5}, 0.038189}, {{4, 5}, 0.059364}, {{5, 3}, 0.111465}, {{5, 4}, 0.111465}, {{6, 5}, 0.111465}, {{7, 5}, 0.202244}, {{7, 4}, 0.202244}, {{7, 3}, 0.111465}, {{6, 3}, 0.111465}, {{1, 8}, 0.167796}, {{7, 6}, 0.265919}, {{8, 6}, 0.265919}, {{9, 6}, 0.265919}, {{9, 5}, 0.265919}, {{9, 4}, 0.265919}, {{8, 4}, 0.265919}, {{5, 8}, 0.423514}, {{0, 9}, 0.500000}, {{0, 7}, 0.500000}, {{2, 9}, 0.072061}, {{3, 9}, 0.927939}, {{5, 9}, 0.144122}, {{5, 10}, 0.072061}, {{6, 10}, 0.000000}, {{7, 10}, 0.000000}, {{7, 9}, 0.000000}, {{7, 8}, 0.000000}, {{6, 8}, 0.000000}, {{8, 11}, 0.000000}, {{8, 12}, 0.000000}, {{8, 13}, 0.000000}, {{9, 13}, 0.000000}, {{10, 13}, 0.000000}, {{10, 12}, 0.000000}, {{10, 11}, 0.000000}, {{9, 11}, 0.000000}}
+            {{{1, 5}, 0.227161}, {{1, 7}, 0.832204}, {{3, 5}, 0.325961}, {{2, 5}, 0.614675}, {{5, 7}, 0.504425}, {{5, 6}, 0.072061}, {{5, 5}, 0.038189}, {{4, 5}, 0.059364}, {{5, 3}, 0.111465}, {{5, 4}, 0.111465}, {{6, 5}, 0.111465}, {{7, 5}, 0.202244}, {{7, 4}, 0.202244}, {{7, 3}, 0.111465}, {{6, 3}, 0.111465}, {{1, 8}, 0.167796}, {{7, 6}, 0.265919}, {{8, 6}, 0.265919}, {{9, 6}, 0.265919}, {{9, 5}, 0.265919}, {{9, 4}, 0.265919}, {{8, 4}, 0.265919}, {{5, 8}, 0.423514}, {{0, 9}, 0.500000}, {{0, 7}, 0.500000}, {{2, 9}, 0.072061}, {{3, 9}, 0.927939}, {{5, 9}, 0.144122}, {{5, 10}, 0.072061}, {{6, 10}, 0.072061}, {{7, 10}, 0.072061}, {{7, 9}, 0.072061}, {{7, 8}, 0.072061}, {{6, 8}, 0.072061}, {{8, 11}, 0.125000}, {{8, 12}, 0.125000}, {{8, 13}, 0.125000}, {{9, 13}, 0.125000}, {{10, 13}, 0.125000}, {{10, 12}, 0.125000}, {{10, 11}, 0.125000}, {{9, 11}, 0.125000}}
         }
     },
     {
@@ -865,7 +877,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{10, 9}, {12, 6}, {11, 9}, {11, 14}},
             {{12, 4}, {10, 12}, {11, 7}, {11, 8}, {11, 6}, {12, 5}},
             267008,
-            {{{4, 3}, 0.313455}, {{4, 4}, 0.228848}, {{4, 5}, 0.228848}, {{5, 5}, 0.228848}, {{6, 5}, 0.228848}, {{6, 4}, 0.228848}, {{6, 3}, 0.228848}, {{5, 3}, 0.313455}, {{3, 1}, 0.228848}, {{3, 2}, 0.228848}, {{3, 3}, 0.228848}, {{5, 2}, 0.228848}, {{5, 1}, 0.228848}, {{4, 1}, 0.228848}, {{14, 4}, 0.500000}, {{13, 4}, 0.500000}, {{8, 5}, 0.125000}, {{8, 6}, 0.125000}, {{8, 7}, 0.125000}, {{9, 7}, 0.125000}, {{10, 7}, 0.125000}, {{10, 6}, 0.125000}, {{10, 5}, 0.125000}, {{9, 5}, 0.125000}, {{7, 9}, 0.250000}, {{7, 10}, 0.250000}, {{7, 11}, 0.250000}, {{8, 11}, 0.250000}, {{9, 11}, 0.250000}, {{9, 10}, 0.250000}, {{9, 9}, 0.250000}, {{8, 9}, 0.000000}, {{10, 10}, 0.000000}, {{10, 11}, 0.000000}, {{10, 13}, 0.000000}, {{10, 14}, 0.000000}}
+            {{{4, 3}, 0.313455}, {{4, 4}, 0.228848}, {{4, 5}, 0.228848}, {{5, 5}, 0.228848}, {{6, 5}, 0.228848}, {{6, 4}, 0.228848}, {{6, 3}, 0.228848}, {{5, 3}, 0.313455}, {{3, 1}, 0.228848}, {{3, 2}, 0.228848}, {{3, 3}, 0.228848}, {{5, 2}, 0.228848}, {{5, 1}, 0.228848}, {{4, 1}, 0.228848}, {{14, 4}, 0.500000}, {{13, 4}, 0.500000}, {{8, 5}, 0.125000}, {{8, 6}, 0.125000}, {{8, 7}, 0.125000}, {{9, 7}, 0.125000}, {{10, 7}, 0.125000}, {{10, 6}, 0.125000}, {{10, 5}, 0.125000}, {{9, 5}, 0.125000}, {{7, 9}, 0.250000}, {{7, 10}, 0.250000}, {{7, 11}, 0.250000}, {{8, 11}, 0.250000}, {{9, 11}, 0.250000}, {{9, 10}, 0.250000}, {{9, 9}, 0.250000}, {{8, 9}, 0.250000}, {{10, 10}, 0.500000}, {{10, 11}, 0.500000}, {{10, 13}, 0.500000}, {{10, 14}, 0.500000}}
         }
     },
     {
@@ -875,7 +887,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{1, 7}, {1, 6}, {9, 14}, {6, 12}, {3, 12}},
             {{1, 3}, {1, 4}, {0, 3}, {1, 12}, {10, 13}, {7, 12}, {9, 12}, {10, 14}, {8, 12}, {10, 12}, {4, 11}, {4, 12}, {6, 11}, {5, 11}, {2, 12}},
             959616,
-            {{{6, 9}, 0.142857}, {{6, 10}, 0.142857}, {{7, 11}, 0.142857}, {{8, 11}, 0.142857}, {{8, 10}, 0.142857}, {{8, 9}, 0.142857}, {{7, 9}, 0.142857}, {{1, 1}, 0.285714}, {{1, 2}, 0.285714}, {{2, 3}, 0.285714}, {{3, 3}, 0.285714}, {{3, 2}, 0.285714}, {{3, 1}, 0.285714}, {{2, 1}, 0.285714}, {{4, 1}, 0.271845}, {{4, 2}, 0.271845}, {{4, 3}, 0.271845}, {{5, 3}, 0.184466}, {{6, 3}, 0.184466}, {{6, 2}, 0.271845}, {{6, 1}, 0.271845}, {{5, 1}, 0.271845}, {{0, 5}, 0.500000}, {{1, 5}, 0.500000}, {{5, 4}, 0.105178}, {{5, 5}, 0.105178}, {{6, 5}, 0.105178}, {{7, 5}, 0.105178}, {{7, 4}, 0.105178}, {{7, 3}, 0.000000}, {{0, 8}, 0.000000}, {{1, 8}, 0.000000}, {{7, 6}, 0.000000}, {{7, 7}, 0.000000}, {{7, 8}, 0.000000}, {{8, 8}, 0.000000}, {{9, 8}, 0.000000}, {{9, 7}, 0.000000}, {{9, 6}, 0.000000}, {{8, 6}, 0.000000}, {{1, 13}, 0.000000}, {{1, 14}, 0.000000}}
+            {{{6, 9}, 0.142857}, {{6, 10}, 0.142857}, {{7, 11}, 0.142857}, {{8, 11}, 0.142857}, {{8, 10}, 0.142857}, {{8, 9}, 0.142857}, {{7, 9}, 0.142857}, {{1, 1}, 0.285714}, {{1, 2}, 0.285714}, {{2, 3}, 0.285714}, {{3, 3}, 0.285714}, {{3, 2}, 0.285714}, {{3, 1}, 0.285714}, {{2, 1}, 0.285714}, {{4, 1}, 0.271845}, {{4, 2}, 0.271845}, {{4, 3}, 0.271845}, {{5, 3}, 0.184466}, {{6, 3}, 0.184466}, {{6, 2}, 0.271845}, {{6, 1}, 0.271845}, {{5, 1}, 0.271845}, {{0, 5}, 0.500000}, {{1, 5}, 0.500000}, {{5, 4}, 0.105178}, {{5, 5}, 0.105178}, {{6, 5}, 0.105178}, {{7, 5}, 0.105178}, {{7, 4}, 0.105178}, {{7, 3}, 0.105178}, {{0, 8}, 0.500000}, {{1, 8}, 0.500000}, {{7, 6}, 0.125000}, {{7, 7}, 0.125000}, {{7, 8}, 0.125000}, {{8, 8}, 0.125000}, {{9, 8}, 0.125000}, {{9, 7}, 0.125000}, {{9, 6}, 0.125000}, {{8, 6}, 0.125000}, {{1, 13}, 0.500000}, {{1, 14}, 0.500000}}
         }
     },
     {
@@ -885,7 +897,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{6, 12}, {3, 12}, {4, 12}},
             {{12, 12}, {1, 12}, {3, 10}, {5, 12}, {5, 10}, {3, 11}, {5, 11}, {4, 10}, {2, 12}},
             58240,
-            {{{8, 1}, 0.187755}, {{8, 2}, 0.087347}, {{8, 3}, 0.087347}, {{9, 3}, 0.087347}, {{10, 3}, 0.087347}, {{10, 2}, 0.087347}, {{10, 1}, 0.187755}, {{9, 1}, 0.187755}, {{8, 0}, 0.218367}, {{10, 0}, 0.218367}, {{11, 0}, 0.125000}, {{11, 1}, 0.125000}, {{11, 2}, 0.125000}, {{12, 2}, 0.125000}, {{13, 2}, 0.125000}, {{13, 1}, 0.125000}, {{13, 0}, 0.125000}, {{12, 0}, 0.125000}, {{8, 4}, 0.375000}, {{8, 5}, 0.375000}, {{8, 6}, 0.375000}, {{9, 6}, 0.375000}, {{10, 6}, 0.375000}, {{10, 5}, 0.375000}, {{10, 4}, 0.375000}, {{9, 4}, 0.375000}, {{6, 11}, 0.085714}, {{8, 11}, 0.457143}, {{7, 11}, 0.457143}, {{9, 11}, 0.085714}, {{10, 11}, 0.457143}, {{11, 11}, 0.457143}, {{12, 13}, 0.000000}, {{12, 11}, 0.000000}, {{1, 13}, 0.000000}, {{1, 14}, 0.000000}, {{12, 14}, 0.000000}}
+            {{{8, 1}, 0.187755}, {{8, 2}, 0.087347}, {{8, 3}, 0.087347}, {{9, 3}, 0.087347}, {{10, 3}, 0.087347}, {{10, 2}, 0.087347}, {{10, 1}, 0.187755}, {{9, 1}, 0.187755}, {{8, 0}, 0.218367}, {{10, 0}, 0.218367}, {{11, 0}, 0.125000}, {{11, 1}, 0.125000}, {{11, 2}, 0.125000}, {{12, 2}, 0.125000}, {{13, 2}, 0.125000}, {{13, 1}, 0.125000}, {{13, 0}, 0.125000}, {{12, 0}, 0.125000}, {{8, 4}, 0.375000}, {{8, 5}, 0.375000}, {{8, 6}, 0.375000}, {{9, 6}, 0.375000}, {{10, 6}, 0.375000}, {{10, 5}, 0.375000}, {{10, 4}, 0.375000}, {{9, 4}, 0.375000}, {{6, 11}, 0.085714}, {{8, 11}, 0.457143}, {{7, 11}, 0.457143}, {{9, 11}, 0.085714}, {{10, 11}, 0.457143}, {{11, 11}, 0.457143}, {{12, 13}, 0.828571}, {{12, 11}, 0.257143}, {{1, 13}, 0.500000}, {{1, 14}, 0.500000}, {{12, 14}, 0.171429}}
         }
     },
     {
@@ -895,7 +907,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{0, 11}, {6, 3}, {6, 6}, {6, 7}, {2, 4}, {5, 9}, {3, 12}, {1, 12}},
             {{3, 3}, {6, 5}, {6, 4}, {0, 5}, {0, 8}, {6, 8}, {6, 9}, {5, 11}, {1, 13}, {5, 10}, {4, 12}, {5, 12}, {2, 13}, {3, 13}, {1, 4}},
             1505280,
-            {{{5, 3}, 0.161017}, {{4, 3}, 0.838983}, {{0, 1}, 0.333333}, {{1, 1}, 0.333333}, {{1, 0}, 0.333333}, {{0, 9}, 0.500000}, {{0, 10}, 0.500000}, {{8, 1}, 0.250000}, {{8, 2}, 0.250000}, {{8, 3}, 0.250000}, {{9, 3}, 0.250000}, {{10, 3}, 0.250000}, {{10, 2}, 0.250000}, {{10, 1}, 0.250000}, {{9, 1}, 0.250000}, {{2, 3}, 0.161017}, {{0, 4}, 0.500000}, {{0, 6}, 0.500000}, {{8, 4}, 0.500000}, {{8, 5}, 0.500000}, {{8, 6}, 0.500000}, {{9, 6}, 0.500000}, {{10, 6}, 0.500000}, {{10, 5}, 0.500000}, {{10, 4}, 0.500000}, {{9, 4}, 0.000000}, {{0, 7}, 0.000000}, {{11, 7}, 0.000000}, {{11, 8}, 0.000000}, {{11, 9}, 0.000000}, {{12, 9}, 0.000000}, {{13, 9}, 0.000000}, {{13, 8}, 0.000000}, {{13, 7}, 0.000000}, {{12, 7}, 0.000000}, {{0, 12}, 0.000000}, {{8, 11}, 0.000000}, {{8, 12}, 0.000000}, {{8, 13}, 0.000000}, {{9, 13}, 0.000000}, {{10, 13}, 0.000000}, {{10, 12}, 0.000000}, {{10, 11}, 0.000000}, {{9, 11}, 0.000000}}
+            {{{5, 3}, 0.161017}, {{4, 3}, 0.838983}, {{0, 1}, 0.333333}, {{1, 1}, 0.333333}, {{1, 0}, 0.333333}, {{0, 9}, 0.500000}, {{0, 10}, 0.500000}, {{8, 1}, 0.250000}, {{8, 2}, 0.250000}, {{8, 3}, 0.250000}, {{9, 3}, 0.250000}, {{10, 3}, 0.250000}, {{10, 2}, 0.250000}, {{10, 1}, 0.250000}, {{9, 1}, 0.250000}, {{2, 3}, 0.161017}, {{0, 4}, 0.500000}, {{0, 6}, 0.500000}, {{8, 4}, 0.500000}, {{8, 5}, 0.500000}, {{8, 6}, 0.500000}, {{9, 6}, 0.500000}, {{10, 6}, 0.500000}, {{10, 5}, 0.500000}, {{10, 4}, 0.500000}, {{9, 4}, 0.500000}, {{0, 7}, 0.500000}, {{11, 7}, 0.125000}, {{11, 8}, 0.125000}, {{11, 9}, 0.125000}, {{12, 9}, 0.125000}, {{13, 9}, 0.125000}, {{13, 8}, 0.125000}, {{13, 7}, 0.125000}, {{12, 7}, 0.125000}, {{0, 12}, 0.500000}, {{8, 11}, 0.125000}, {{8, 12}, 0.125000}, {{8, 13}, 0.125000}, {{9, 13}, 0.125000}, {{10, 13}, 0.125000}, {{10, 12}, 0.125000}, {{10, 11}, 0.125000}, {{9, 11}, 0.125000}}
         }
     },
     {
@@ -905,7 +917,7 @@ inline std::vector<TestPosition> mediumCases = {
             {{12, 5}, {12, 7}},
             {{12, 6}, {12, 4}, {12, 3}, {12, 8}},
             1090600,
-            {{{10, 0}, 0.200000}, {{10, 1}, 0.200000}, {{11, 1}, 0.200000}, {{12, 1}, 0.200000}, {{12, 0}, 0.200000}, {{14, 3}, 0.500000}, {{13, 3}, 0.500000}, {{8, 5}, 0.191385}, {{8, 6}, 0.191385}, {{8, 7}, 0.191385}, {{9, 7}, 0.521538}, {{10, 6}, 0.521538}, {{10, 5}, 0.191385}, {{9, 5}, 0.191385}, {{4, 6}, 0.099408}, {{4, 7}, 0.099408}, {{4, 8}, 0.304144}, {{5, 8}, 0.099408}, {{6, 8}, 0.099408}, {{6, 7}, 0.099408}, {{6, 6}, 0.099408}, {{5, 6}, 0.099408}, {{9, 8}, 0.391385}, {{10, 8}, 0.391385}, {{11, 8}, 0.391385}, {{11, 7}, 0.391385}, {{11, 6}, 0.391385}, {{13, 8}, 0.000000}, {{14, 8}, 0.000000}, {{2, 8}, 0.000000}, {{2, 9}, 0.000000}, {{2, 10}, 0.000000}, {{3, 10}, 0.000000}, {{4, 10}, 0.000000}, {{4, 9}, 0.000000}, {{3, 8}, 0.000000}}
+            {{{10, 0}, 0.200000}, {{10, 1}, 0.200000}, {{11, 1}, 0.200000}, {{12, 1}, 0.200000}, {{12, 0}, 0.200000}, {{14, 3}, 0.500000}, {{13, 3}, 0.500000}, {{8, 5}, 0.191385}, {{8, 6}, 0.191385}, {{8, 7}, 0.191385}, {{9, 7}, 0.521538}, {{10, 6}, 0.521538}, {{10, 5}, 0.191385}, {{9, 5}, 0.191385}, {{4, 6}, 0.099408}, {{4, 7}, 0.099408}, {{4, 8}, 0.304144}, {{5, 8}, 0.099408}, {{6, 8}, 0.099408}, {{6, 7}, 0.099408}, {{6, 6}, 0.099408}, {{5, 6}, 0.099408}, {{9, 8}, 0.391385}, {{10, 8}, 0.391385}, {{11, 8}, 0.391385}, {{11, 7}, 0.391385}, {{11, 6}, 0.391385}, {{13, 8}, 0.500000}, {{14, 8}, 0.500000}, {{2, 8}, 0.385122}, {{2, 9}, 0.385122}, {{2, 10}, 0.385122}, {{3, 10}, 0.385122}, {{4, 10}, 0.385122}, {{4, 9}, 0.385122}, {{3, 8}, 0.385122}}
         }
     }
 };
@@ -918,7 +930,7 @@ inline std::vector<TestPosition> hardCases = {
             {},
             {},
             183744000,
-            {{{8, 0}, 0.200000}, {{8, 1}, 0.200000}, {{9, 1}, 0.200000}, {{10, 1}, 0.200000}, {{10, 0}, 0.200000}, {{0, 7}, 0.400000}, {{1, 7}, 0.400000}, {{1, 6}, 0.400000}, {{1, 5}, 0.400000}, {{0, 5}, 0.400000}, {{9, 3}, 0.654679}, {{9, 4}, 0.654679}, {{9, 5}, 0.847625}, {{10, 5}, 0.439491}, {{11, 5}, 0.439491}, {{11, 4}, 0.654679}, {{11, 3}, 0.654679}, {{10, 3}, 0.654679}, {{3, 6}, 0.077225}, {{3, 7}, 0.132592}, {{3, 8}, 0.132592}, {{5, 8}, 0.132592}, {{5, 7}, 0.326111}, {{4, 6}, 0.198888}, {{4, 5}, 0.295000}, {{6, 7}, 0.295000}, {{6, 6}, 0.295000}, {{6, 5}, 0.295000}, {{5, 5}, 0.295000}, {{3, 9}, 0.092038}, {{4, 9}, 0.092038}, {{5, 9}, 0.092038}, {{9, 6}, 0.000000}, {{9, 7}, 0.000000}, {{10, 7}, 0.000000}, {{11, 7}, 0.000000}, {{12, 7}, 0.000000}, {{12, 6}, 0.000000}, {{12, 5}, 0.000000}, {{12, 8}, 0.000000}, {{12, 9}, 0.000000}, {{12, 10}, 0.000000}, {{13, 10}, 0.000000}, {{14, 10}, 0.000000}, {{14, 9}, 0.000000}, {{14, 8}, 0.000000}, {{13, 8}, 0.000000}, {{8, 11}, 0.000000}, {{8, 12}, 0.000000}, {{8, 13}, 0.000000}, {{9, 13}, 0.000000}, {{10, 13}, 0.000000}, {{10, 11}, 0.000000}, {{9, 11}, 0.000000}, {{11, 12}, 0.000000}, {{11, 11}, 0.000000}, {{10, 14}, 0.000000}, {{11, 14}, 0.000000}, {{12, 14}, 0.000000}, {{12, 13}, 0.000000}, {{12, 12}, 0.000000}}
+            {{{8, 0}, 0.200000}, {{8, 1}, 0.200000}, {{9, 1}, 0.200000}, {{10, 1}, 0.200000}, {{10, 0}, 0.200000}, {{0, 7}, 0.400000}, {{1, 7}, 0.400000}, {{1, 6}, 0.400000}, {{1, 5}, 0.400000}, {{0, 5}, 0.400000}, {{9, 3}, 0.654679}, {{9, 4}, 0.654679}, {{9, 5}, 0.847625}, {{10, 5}, 0.439491}, {{11, 5}, 0.439491}, {{11, 4}, 0.654679}, {{11, 3}, 0.654679}, {{10, 3}, 0.654679}, {{3, 6}, 0.077225}, {{3, 7}, 0.132592}, {{3, 8}, 0.132592}, {{5, 8}, 0.132592}, {{5, 7}, 0.326111}, {{4, 6}, 0.198888}, {{4, 5}, 0.295000}, {{6, 7}, 0.295000}, {{6, 6}, 0.295000}, {{6, 5}, 0.295000}, {{5, 5}, 0.295000}, {{3, 9}, 0.092038}, {{4, 9}, 0.092038}, {{5, 9}, 0.092038}, {{9, 6}, 0.097402}, {{9, 7}, 0.097402}, {{10, 7}, 0.039294}, {{11, 7}, 0.039294}, {{12, 7}, 0.014143}, {{12, 6}, 0.014143}, {{12, 5}, 0.014143}, {{12, 8}, 0.125000}, {{12, 9}, 0.125000}, {{12, 10}, 0.125000}, {{13, 10}, 0.125000}, {{14, 10}, 0.125000}, {{14, 9}, 0.125000}, {{14, 8}, 0.125000}, {{13, 8}, 0.125000}, {{8, 11}, 0.363408}, {{8, 12}, 0.363408}, {{8, 13}, 0.363408}, {{9, 13}, 0.228537}, {{10, 13}, 0.224164}, {{10, 11}, 0.228537}, {{9, 11}, 0.228537}, {{11, 12}, 0.045707}, {{11, 11}, 0.044516}, {{10, 14}, 0.146026}, {{11, 14}, 0.146026}, {{12, 14}, 0.146026}, {{12, 13}, 0.146026}, {{12, 12}, 0.146026}}
         }
     },
     {
@@ -928,7 +940,7 @@ inline std::vector<TestPosition> hardCases = {
             {{9, 2}, {10, 6}, {12, 6}, {14, 6}, {11, 2}, {14, 1}},
             {{9, 5}, {11, 6}, {13, 6}, {11, 1}, {13, 1}, {12, 1}, {10, 2}},
             332800,
-            {{{5, 11}, 0.125000}, {{5, 12}, 0.125000}, {{5, 13}, 0.125000}, {{6, 13}, 0.125000}, {{7, 13}, 0.125000}, {{7, 12}, 0.125000}, {{7, 11}, 0.125000}, {{6, 11}, 0.125000}, {{7, 2}, 0.223859}, {{7, 3}, 0.164212}, {{7, 4}, 0.164212}, {{8, 4}, 0.223859}, {{9, 4}, 0.818227}, {{9, 3}, 0.181773}, {{8, 2}, 0.223859}, {{2, 10}, 0.125000}, {{2, 11}, 0.125000}, {{2, 12}, 0.125000}, {{3, 12}, 0.125000}, {{4, 12}, 0.125000}, {{4, 11}, 0.125000}, {{4, 10}, 0.125000}, {{3, 10}, 0.125000}, {{9, 7}, 0.166291}, {{9, 9}, 0.166291}, {{10, 9}, 0.166291}, {{11, 9}, 0.111612}, {{11, 8}, 0.111612}, {{11, 7}, 0.111612}, {{10, 7}, 0.166291}, {{5, 3}, 0.111929}, {{5, 4}, 0.000000}, {{5, 5}, 0.000000}, {{6, 5}, 0.000000}, {{7, 5}, 0.000000}, {{6, 3}, 0.000000}, {{9, 6}, 0.000000}, {{8, 7}, 0.000000}, {{8, 8}, 0.000000}, {{8, 9}, 0.000000}, {{11, 13}, 0.000000}, {{11, 14}, 0.000000}, {{13, 14}, 0.000000}, {{13, 13}, 0.000000}, {{12, 13}, 0.000000}}
+            {{{5, 11}, 0.125000}, {{5, 12}, 0.125000}, {{5, 13}, 0.125000}, {{6, 13}, 0.125000}, {{7, 13}, 0.125000}, {{7, 12}, 0.125000}, {{7, 11}, 0.125000}, {{6, 11}, 0.125000}, {{7, 2}, 0.223859}, {{7, 3}, 0.164212}, {{7, 4}, 0.164212}, {{8, 4}, 0.223859}, {{9, 4}, 0.818227}, {{9, 3}, 0.181773}, {{8, 2}, 0.223859}, {{2, 10}, 0.125000}, {{2, 11}, 0.125000}, {{2, 12}, 0.125000}, {{3, 12}, 0.125000}, {{4, 12}, 0.125000}, {{4, 11}, 0.125000}, {{4, 10}, 0.125000}, {{3, 10}, 0.125000}, {{9, 7}, 0.166291}, {{9, 9}, 0.166291}, {{10, 9}, 0.166291}, {{11, 9}, 0.111612}, {{11, 8}, 0.111612}, {{11, 7}, 0.111612}, {{10, 7}, 0.166291}, {{5, 3}, 0.111929}, {{5, 4}, 0.111929}, {{5, 5}, 0.111929}, {{6, 5}, 0.111929}, {{7, 5}, 0.111929}, {{6, 3}, 0.111929}, {{9, 6}, 0.181773}, {{8, 7}, 0.111612}, {{8, 8}, 0.111612}, {{8, 9}, 0.111612}, {{11, 13}, 0.400000}, {{11, 14}, 0.400000}, {{13, 14}, 0.400000}, {{13, 13}, 0.400000}, {{12, 13}, 0.400000}}
         }
     },
     {
@@ -938,7 +950,7 @@ inline std::vector<TestPosition> hardCases = {
             {{12, 7}, {12, 8}},
             {{12, 9}, {12, 10}, {12, 11}},
             10536960,
-            {{{5, 3}, 0.125000}, {{5, 4}, 0.125000}, {{5, 5}, 0.125000}, {{6, 5}, 0.125000}, {{7, 5}, 0.125000}, {{7, 4}, 0.125000}, {{7, 3}, 0.125000}, {{6, 3}, 0.125000}, {{0, 2}, 0.125000}, {{0, 3}, 0.125000}, {{0, 4}, 0.125000}, {{1, 4}, 0.125000}, {{2, 4}, 0.125000}, {{2, 3}, 0.125000}, {{2, 2}, 0.125000}, {{1, 2}, 0.125000}, {{9, 2}, 0.250000}, {{9, 3}, 0.250000}, {{9, 4}, 0.250000}, {{10, 4}, 0.250000}, {{11, 4}, 0.250000}, {{11, 3}, 0.250000}, {{11, 2}, 0.250000}, {{10, 2}, 0.250000}, {{12, 5}, 0.200000}, {{12, 6}, 0.200000}, {{13, 7}, 0.500000}, {{14, 7}, 0.500000}, {{14, 6}, 0.200000}, {{14, 5}, 0.200000}, {{13, 5}, 0.200000}, {{8, 12}, 0.000000}, {{8, 13}, 0.000000}, {{8, 14}, 0.000000}, {{9, 14}, 0.000000}, {{10, 14}, 0.000000}, {{10, 13}, 0.000000}, {{10, 12}, 0.000000}, {{9, 12}, 0.000000}, {{13, 11}, 0.000000}, {{14, 11}, 0.000000}, {{11, 11}, 0.000000}, {{11, 12}, 0.000000}, {{11, 13}, 0.000000}, {{12, 13}, 0.000000}, {{13, 13}, 0.000000}, {{13, 12}, 0.000000}}
+            {{{5, 3}, 0.125000}, {{5, 4}, 0.125000}, {{5, 5}, 0.125000}, {{6, 5}, 0.125000}, {{7, 5}, 0.125000}, {{7, 4}, 0.125000}, {{7, 3}, 0.125000}, {{6, 3}, 0.125000}, {{0, 2}, 0.125000}, {{0, 3}, 0.125000}, {{0, 4}, 0.125000}, {{1, 4}, 0.125000}, {{2, 4}, 0.125000}, {{2, 3}, 0.125000}, {{2, 2}, 0.125000}, {{1, 2}, 0.125000}, {{9, 2}, 0.250000}, {{9, 3}, 0.250000}, {{9, 4}, 0.250000}, {{10, 4}, 0.250000}, {{11, 4}, 0.250000}, {{11, 3}, 0.250000}, {{11, 2}, 0.250000}, {{10, 2}, 0.250000}, {{12, 5}, 0.200000}, {{12, 6}, 0.200000}, {{13, 7}, 0.500000}, {{14, 7}, 0.500000}, {{14, 6}, 0.200000}, {{14, 5}, 0.200000}, {{13, 5}, 0.200000}, {{8, 12}, 0.250000}, {{8, 13}, 0.250000}, {{8, 14}, 0.250000}, {{9, 14}, 0.250000}, {{10, 14}, 0.250000}, {{10, 13}, 0.250000}, {{10, 12}, 0.250000}, {{9, 12}, 0.250000}, {{13, 11}, 0.656863}, {{14, 11}, 0.343137}, {{11, 11}, 0.223856}, {{11, 12}, 0.223856}, {{11, 13}, 0.223856}, {{12, 13}, 0.223856}, {{13, 13}, 0.223856}, {{13, 12}, 0.223856}}
         }
     },
     {
@@ -948,7 +960,7 @@ inline std::vector<TestPosition> hardCases = {
             {{13, 7}, {5, 14}, {11, 8}, {6, 14}, {9, 6}, {5, 10}, {6, 10}, {2, 11}, {11, 12}, {1, 13}, {10, 14}, {6, 7}, {13, 12}},
             {{12, 7}, {14, 7}, {1, 10}, {2, 10}, {1, 14}, {11, 7}, {10, 6}, {0, 10}, {0, 11}, {0, 12}, {1, 12}, {8, 6}, {4, 10}, {3, 10}, {11, 14}, {11, 13}, {6, 8}, {6, 9}, {12, 12}, {14, 12}, {6, 6}, {7, 6}, {11, 6}},
             2084940,
-            {{{0, 5}, 0.099426}, {{0, 6}, 0.099426}, {{0, 7}, 0.099426}, {{1, 7}, 0.099426}, {{2, 7}, 0.167623}, {{2, 6}, 0.167623}, {{2, 5}, 0.167623}, {{1, 5}, 0.099426}, {{12, 3}, 0.381100}, {{12, 4}, 0.206300}, {{12, 5}, 0.206300}, {{13, 5}, 0.206300}, {{14, 5}, 0.206300}, {{14, 4}, 0.206300}, {{14, 3}, 0.206300}, {{13, 3}, 0.381100}, {{8, 0}, 0.372347}, {{8, 1}, 0.241553}, {{8, 2}, 0.158302}, {{10, 2}, 0.241553}, {{10, 1}, 0.241553}, {{10, 0}, 0.372347}, {{9, 0}, 0.372347}, {{9, 3}, 0.048311}, {{10, 3}, 0.068730}, {{11, 1}, 0.372967}, {{11, 2}, 0.372967}, {{11, 3}, 0.372967}, {{13, 2}, 0.372967}, {{13, 1}, 0.000000}, {{12, 1}, 0.000000}, {{7, 2}, 0.000000}, {{7, 3}, 0.000000}, {{7, 4}, 0.000000}, {{8, 4}, 0.000000}, {{9, 4}, 0.000000}, {{3, 7}, 0.000000}, {{4, 7}, 0.000000}, {{4, 6}, 0.000000}, {{4, 5}, 0.000000}, {{3, 5}, 0.000000}}
+            {{{0, 5}, 0.099426}, {{0, 6}, 0.099426}, {{0, 7}, 0.099426}, {{1, 7}, 0.099426}, {{2, 7}, 0.167623}, {{2, 6}, 0.167623}, {{2, 5}, 0.167623}, {{1, 5}, 0.099426}, {{12, 3}, 0.381100}, {{12, 4}, 0.206300}, {{12, 5}, 0.206300}, {{13, 5}, 0.206300}, {{14, 5}, 0.206300}, {{14, 4}, 0.206300}, {{14, 3}, 0.206300}, {{13, 3}, 0.381100}, {{8, 0}, 0.372347}, {{8, 1}, 0.241553}, {{8, 2}, 0.158302}, {{10, 2}, 0.241553}, {{10, 1}, 0.241553}, {{10, 0}, 0.372347}, {{9, 0}, 0.372347}, {{9, 3}, 0.048311}, {{10, 3}, 0.068730}, {{11, 1}, 0.372967}, {{11, 2}, 0.372967}, {{11, 3}, 0.372967}, {{13, 2}, 0.372967}, {{13, 1}, 0.372967}, {{12, 1}, 0.372967}, {{7, 2}, 0.158678}, {{7, 3}, 0.158678}, {{7, 4}, 0.158678}, {{8, 4}, 0.158678}, {{9, 4}, 0.158678}, {{3, 7}, 0.299426}, {{4, 7}, 0.299426}, {{4, 6}, 0.299426}, {{4, 5}, 0.299426}, {{3, 5}, 0.299426}}
         }
     },
     {
@@ -958,7 +970,7 @@ inline std::vector<TestPosition> hardCases = {
             {{0, 12}, {4, 9}, {2, 12}, {2, 8}},
             {{1, 12}, {4, 12}, {4, 13}, {4, 14}, {2, 7}, {3, 12}, {2, 13}, {2, 14}, {3, 14}, {3, 8}},
             4867072,
-            {{{11, 6}, 0.250000}, {{11, 7}, 0.250000}, {{11, 8}, 0.250000}, {{12, 8}, 0.250000}, {{13, 8}, 0.250000}, {{13, 7}, 0.250000}, {{13, 6}, 0.250000}, {{12, 6}, 0.250000}, {{1, 7}, 0.500000}, {{0, 7}, 0.500000}, {{5, 14}, 0.213592}, {{6, 14}, 0.213592}, {{6, 13}, 0.213592}, {{6, 12}, 0.145631}, {{5, 12}, 0.213592}, {{8, 0}, 0.125000}, {{8, 1}, 0.125000}, {{8, 2}, 0.125000}, {{9, 2}, 0.125000}, {{10, 2}, 0.125000}, {{10, 1}, 0.125000}, {{10, 0}, 0.125000}, {{9, 0}, 0.125000}, {{3, 2}, 0.375000}, {{3, 3}, 0.375000}, {{3, 4}, 0.375000}, {{4, 4}, 0.375000}, {{5, 4}, 0.000000}, {{5, 3}, 0.000000}, {{5, 2}, 0.000000}, {{4, 2}, 0.000000}, {{4, 10}, 0.000000}, {{4, 8}, 0.000000}, {{4, 11}, 0.000000}, {{6, 10}, 0.000000}, {{6, 11}, 0.000000}, {{7, 12}, 0.000000}, {{8, 12}, 0.000000}, {{8, 11}, 0.000000}, {{8, 10}, 0.000000}, {{7, 10}, 0.000000}, {{9, 12}, 0.000000}, {{10, 12}, 0.000000}, {{10, 11}, 0.000000}, {{10, 10}, 0.000000}, {{9, 10}, 0.000000}}
+            {{{11, 6}, 0.250000}, {{11, 7}, 0.250000}, {{11, 8}, 0.250000}, {{12, 8}, 0.250000}, {{13, 8}, 0.250000}, {{13, 7}, 0.250000}, {{13, 6}, 0.250000}, {{12, 6}, 0.250000}, {{1, 7}, 0.500000}, {{0, 7}, 0.500000}, {{5, 14}, 0.213592}, {{6, 14}, 0.213592}, {{6, 13}, 0.213592}, {{6, 12}, 0.145631}, {{5, 12}, 0.213592}, {{8, 0}, 0.125000}, {{8, 1}, 0.125000}, {{8, 2}, 0.125000}, {{9, 2}, 0.125000}, {{10, 2}, 0.125000}, {{10, 1}, 0.125000}, {{10, 0}, 0.125000}, {{9, 0}, 0.125000}, {{3, 2}, 0.375000}, {{3, 3}, 0.375000}, {{3, 4}, 0.375000}, {{4, 4}, 0.375000}, {{5, 4}, 0.375000}, {{5, 3}, 0.375000}, {{5, 2}, 0.375000}, {{4, 2}, 0.375000}, {{4, 10}, 0.824171}, {{4, 8}, 0.175829}, {{4, 11}, 0.175829}, {{6, 10}, 0.126214}, {{6, 11}, 0.126214}, {{7, 12}, 0.126214}, {{8, 12}, 0.116505}, {{8, 11}, 0.116505}, {{8, 10}, 0.116505}, {{7, 10}, 0.126214}, {{9, 12}, 0.130097}, {{10, 12}, 0.130097}, {{10, 11}, 0.130097}, {{10, 10}, 0.130097}, {{9, 10}, 0.130097}}
         }
     },
     {
@@ -968,7 +980,7 @@ inline std::vector<TestPosition> hardCases = {
             {{1, 0}, {3, 0}, {2, 4}, {4, 1}},
             {{0, 0}, {2, 0}, {4, 0}, {2, 7}, {0, 9}, {1, 9}, {1, 8}, {4, 2}, {2, 5}, {4, 3}, {3, 4}, {4, 4}, {2, 6}},
             6096384,
-            {{{7, 8}, 0.190783}, {{7, 9}, 0.190783}, {{7, 10}, 0.427652}, {{8, 10}, 0.427652}, {{9, 10}, 0.190783}, {{9, 9}, 0.190783}, {{9, 8}, 0.190783}, {{8, 8}, 0.190783}, {{6, 0}, 0.250000}, {{6, 1}, 0.250000}, {{6, 2}, 0.250000}, {{7, 2}, 0.250000}, {{8, 2}, 0.250000}, {{8, 1}, 0.250000}, {{8, 0}, 0.250000}, {{7, 0}, 0.250000}, {{7, 3}, 0.125000}, {{7, 4}, 0.125000}, {{7, 5}, 0.125000}, {{8, 5}, 0.125000}, {{9, 5}, 0.125000}, {{9, 4}, 0.125000}, {{9, 3}, 0.125000}, {{8, 3}, 0.125000}, {{0, 7}, 0.500000}, {{1, 7}, 0.500000}, {{6, 10}, 0.000000}, {{6, 11}, 0.000000}, {{6, 12}, 0.000000}, {{7, 12}, 0.000000}, {{8, 12}, 0.000000}, {{8, 11}, 0.000000}, {{0, 12}, 0.000000}, {{0, 13}, 0.000000}, {{0, 14}, 0.000000}, {{1, 14}, 0.000000}, {{2, 14}, 0.000000}, {{2, 13}, 0.000000}, {{2, 12}, 0.000000}, {{1, 12}, 0.000000}}
+            {{{7, 8}, 0.190783}, {{7, 9}, 0.190783}, {{7, 10}, 0.427652}, {{8, 10}, 0.427652}, {{9, 10}, 0.190783}, {{9, 9}, 0.190783}, {{9, 8}, 0.190783}, {{8, 8}, 0.190783}, {{6, 0}, 0.250000}, {{6, 1}, 0.250000}, {{6, 2}, 0.250000}, {{7, 2}, 0.250000}, {{8, 2}, 0.250000}, {{8, 1}, 0.250000}, {{8, 0}, 0.250000}, {{7, 0}, 0.250000}, {{7, 3}, 0.125000}, {{7, 4}, 0.125000}, {{7, 5}, 0.125000}, {{8, 5}, 0.125000}, {{9, 5}, 0.125000}, {{9, 4}, 0.125000}, {{9, 3}, 0.125000}, {{8, 3}, 0.125000}, {{0, 7}, 0.500000}, {{1, 7}, 0.500000}, {{6, 10}, 0.357449}, {{6, 11}, 0.357449}, {{6, 12}, 0.357449}, {{7, 12}, 0.357449}, {{8, 12}, 0.357449}, {{8, 11}, 0.357449}, {{0, 12}, 0.250000}, {{0, 13}, 0.250000}, {{0, 14}, 0.250000}, {{1, 14}, 0.250000}, {{2, 14}, 0.250000}, {{2, 13}, 0.250000}, {{2, 12}, 0.250000}, {{1, 12}, 0.250000}}
         }
     },
     {
@@ -978,7 +990,7 @@ inline std::vector<TestPosition> hardCases = {
             {{9, 4}, {5, 3}, {6, 8}, {3, 5}, {6, 3}, {1, 8}, {1, 9}, {4, 10}},
             {{9, 9}, {1, 7}, {6, 9}, {7, 3}, {9, 3}, {8, 3}, {3, 4}, {1, 5}, {1, 6}, {2, 5}, {1, 10}, {2, 10}, {3, 10}, {3, 3}, {4, 3}, {5, 10}, {6, 10}},
             59176320,
-            {{{0, 1}, 0.375000}, {{0, 2}, 0.375000}, {{0, 3}, 0.375000}, {{1, 3}, 0.375000}, {{2, 3}, 0.375000}, {{2, 2}, 0.375000}, {{2, 1}, 0.375000}, {{1, 1}, 0.375000}, {{9, 0}, 0.250000}, {{9, 1}, 0.250000}, {{9, 2}, 0.250000}, {{10, 2}, 0.250000}, {{11, 2}, 0.250000}, {{11, 1}, 0.250000}, {{11, 0}, 0.250000}, {{10, 0}, 0.250000}, {{13, 2}, 0.200000}, {{13, 3}, 0.200000}, {{13, 4}, 0.200000}, {{14, 4}, 0.200000}, {{14, 2}, 0.200000}, {{7, 9}, 0.148596}, {{8, 9}, 0.851404}, {{10, 9}, 0.312390}, {{10, 8}, 0.418103}, {{10, 7}, 0.418103}, {{10, 3}, 0.213269}, {{10, 4}, 0.418103}, {{10, 5}, 0.418103}, {{11, 5}, 0.155358}, {{12, 5}, 0.155358}, {{12, 4}, 0.000000}, {{12, 3}, 0.000000}, {{11, 3}, 0.000000}, {{10, 6}, 0.000000}, {{11, 6}, 0.000000}, {{11, 7}, 0.000000}, {{12, 7}, 0.000000}, {{13, 7}, 0.000000}, {{13, 6}, 0.000000}, {{13, 5}, 0.000000}, {{11, 9}, 0.000000}, {{11, 10}, 0.000000}, {{11, 11}, 0.000000}, {{12, 11}, 0.000000}, {{13, 11}, 0.000000}, {{13, 9}, 0.000000}, {{12, 9}, 0.000000}, {{14, 11}, 0.000000}, {{14, 10}, 0.000000}, {{14, 9}, 0.000000}}
+            {{{0, 1}, 0.375000}, {{0, 2}, 0.375000}, {{0, 3}, 0.375000}, {{1, 3}, 0.375000}, {{2, 3}, 0.375000}, {{2, 2}, 0.375000}, {{2, 1}, 0.375000}, {{1, 1}, 0.375000}, {{9, 0}, 0.250000}, {{9, 1}, 0.250000}, {{9, 2}, 0.250000}, {{10, 2}, 0.250000}, {{11, 2}, 0.250000}, {{11, 1}, 0.250000}, {{11, 0}, 0.250000}, {{10, 0}, 0.250000}, {{13, 2}, 0.200000}, {{13, 3}, 0.200000}, {{13, 4}, 0.200000}, {{14, 4}, 0.200000}, {{14, 2}, 0.200000}, {{7, 9}, 0.148596}, {{8, 9}, 0.851404}, {{10, 9}, 0.312390}, {{10, 8}, 0.418103}, {{10, 7}, 0.418103}, {{10, 3}, 0.213269}, {{10, 4}, 0.418103}, {{10, 5}, 0.418103}, {{11, 5}, 0.155358}, {{12, 5}, 0.155358}, {{12, 4}, 0.213269}, {{12, 3}, 0.213269}, {{11, 3}, 0.213269}, {{10, 6}, 0.163794}, {{11, 6}, 0.114881}, {{11, 7}, 0.114881}, {{12, 7}, 0.114881}, {{13, 7}, 0.114881}, {{13, 6}, 0.114881}, {{13, 5}, 0.114881}, {{11, 9}, 0.203596}, {{11, 10}, 0.203596}, {{11, 11}, 0.203596}, {{12, 11}, 0.347303}, {{13, 11}, 0.347303}, {{13, 9}, 0.347303}, {{12, 9}, 0.347303}, {{14, 11}, 0.203596}, {{14, 10}, 0.203596}, {{14, 9}, 0.203596}}
         }
     },
     {
@@ -988,7 +1000,7 @@ inline std::vector<TestPosition> hardCases = {
             {},
             {},
             36796032,
-            {{{12, 2}, 0.666667}, {{12, 3}, 0.666667}, {{12, 4}, 0.666667}, {{13, 4}, 0.250000}, {{14, 4}, 0.250000}, {{14, 2}, 0.250000}, {{13, 2}, 0.250000}, {{8, 6}, 0.125000}, {{8, 7}, 0.125000}, {{8, 8}, 0.125000}, {{9, 8}, 0.125000}, {{10, 8}, 0.125000}, {{10, 7}, 0.125000}, {{10, 6}, 0.125000}, {{9, 6}, 0.125000}, {{5, 0}, 0.549279}, {{5, 1}, 0.549279}, {{6, 1}, 0.450721}, {{7, 1}, 0.450721}, {{3, 10}, 0.157722}, {{3, 11}, 0.263183}, {{3, 12}, 0.263183}, {{4, 12}, 0.263183}, {{5, 12}, 0.263183}, {{5, 11}, 0.263183}, {{5, 10}, 0.263183}, {{4, 10}, 0.263183}, {{8, 1}, 0.049279}, {{8, 0}, 0.049279}, {{1, 8}, 0.105367}, {{1, 9}, 0.157722}, {{1, 10}, 0.157722}, {{2, 10}, 0.000000}, {{3, 9}, 0.000000}, {{3, 8}, 0.000000}, {{2, 8}, 0.000000}, {{0, 11}, 0.000000}, {{1, 11}, 0.000000}, {{0, 9}, 0.000000}, {{6, 11}, 0.000000}, {{6, 12}, 0.000000}, {{6, 13}, 0.000000}, {{7, 13}, 0.000000}, {{8, 13}, 0.000000}, {{8, 11}, 0.000000}, {{7, 11}, 0.000000}, {{9, 13}, 0.000000}, {{9, 12}, 0.000000}, {{9, 11}, 0.000000}, {{11, 11}, 0.000000}, {{11, 12}, 0.000000}, {{11, 13}, 0.000000}, {{13, 13}, 0.000000}, {{13, 12}, 0.000000}, {{13, 11}, 0.000000}, {{12, 11}, 0.000000}, {{11, 14}, 0.000000}, {{12, 14}, 0.000000}, {{13, 14}, 0.000000}}
+            {{{12, 2}, 0.666667}, {{12, 3}, 0.666667}, {{12, 4}, 0.666667}, {{13, 4}, 0.250000}, {{14, 4}, 0.250000}, {{14, 2}, 0.250000}, {{13, 2}, 0.250000}, {{8, 6}, 0.125000}, {{8, 7}, 0.125000}, {{8, 8}, 0.125000}, {{9, 8}, 0.125000}, {{10, 8}, 0.125000}, {{10, 7}, 0.125000}, {{10, 6}, 0.125000}, {{9, 6}, 0.125000}, {{5, 0}, 0.549279}, {{5, 1}, 0.549279}, {{6, 1}, 0.450721}, {{7, 1}, 0.450721}, {{3, 10}, 0.157722}, {{3, 11}, 0.263183}, {{3, 12}, 0.263183}, {{4, 12}, 0.263183}, {{5, 12}, 0.263183}, {{5, 11}, 0.263183}, {{5, 10}, 0.263183}, {{4, 10}, 0.263183}, {{8, 1}, 0.049279}, {{8, 0}, 0.049279}, {{1, 8}, 0.105367}, {{1, 9}, 0.157722}, {{1, 10}, 0.157722}, {{2, 10}, 0.105367}, {{3, 9}, 0.105367}, {{3, 8}, 0.105367}, {{2, 8}, 0.105367}, {{0, 11}, 0.228185}, {{1, 11}, 0.228185}, {{0, 9}, 0.228185}, {{6, 11}, 0.110652}, {{6, 12}, 0.110652}, {{6, 13}, 0.110652}, {{7, 13}, 0.167011}, {{8, 13}, 0.167011}, {{8, 11}, 0.167011}, {{7, 11}, 0.167011}, {{9, 13}, 0.110652}, {{9, 12}, 0.110652}, {{9, 11}, 0.110652}, {{11, 11}, 0.110652}, {{11, 12}, 0.167011}, {{11, 13}, 0.167011}, {{13, 13}, 0.167011}, {{13, 12}, 0.167011}, {{13, 11}, 0.110652}, {{12, 11}, 0.110652}, {{11, 14}, 0.110652}, {{12, 14}, 0.110652}, {{13, 14}, 0.110652}}
         }
     },
     {
@@ -998,7 +1010,7 @@ inline std::vector<TestPosition> hardCases = {
             {{1, 14}, {5, 12}, {6, 12}, {2, 10}},
             {{7, 12}, {5, 10}, {3, 10}, {4, 10}, {5, 11}, {1, 10}},
             9805824,
-            {{{7, 0}, 0.139947}, {{7, 1}, 0.181644}, {{8, 1}, 0.398515}, {{9, 1}, 0.139947}, {{9, 0}, 0.139947}, {{5, 1}, 0.055914}, {{5, 2}, 0.055914}, {{5, 3}, 0.055914}, {{6, 3}, 0.216871}, {{7, 3}, 0.216871}, {{6, 1}, 0.216871}, {{8, 3}, 0.384614}, {{8, 2}, 0.384614}, {{12, 1}, 0.125000}, {{12, 2}, 0.125000}, {{12, 3}, 0.125000}, {{13, 3}, 0.125000}, {{14, 3}, 0.125000}, {{14, 2}, 0.125000}, {{14, 1}, 0.125000}, {{13, 1}, 0.125000}, {{10, 12}, 0.375000}, {{10, 13}, 0.375000}, {{10, 14}, 0.375000}, {{11, 14}, 0.375000}, {{12, 14}, 0.375000}, {{12, 13}, 0.375000}, {{12, 12}, 0.375000}, {{11, 12}, 0.375000}, {{2, 4}, 0.138207}, {{2, 5}, 0.138207}, {{2, 6}, 0.121054}, {{3, 6}, 0.000000}, {{4, 6}, 0.000000}, {{4, 5}, 0.000000}, {{4, 4}, 0.000000}, {{3, 4}, 0.000000}, {{5, 6}, 0.000000}, {{6, 6}, 0.000000}, {{6, 5}, 0.000000}, {{6, 4}, 0.000000}, {{5, 4}, 0.000000}, {{2, 7}, 0.000000}, {{2, 8}, 0.000000}, {{3, 8}, 0.000000}, {{4, 8}, 0.000000}, {{4, 7}, 0.000000}, {{0, 10}, 0.000000}, {{0, 11}, 0.000000}, {{0, 12}, 0.000000}, {{0, 13}, 0.000000}, {{0, 14}, 0.000000}, {{7, 14}, 0.000000}, {{7, 13}, 0.000000}}
+            {{{7, 0}, 0.139947}, {{7, 1}, 0.181644}, {{8, 1}, 0.398515}, {{9, 1}, 0.139947}, {{9, 0}, 0.139947}, {{5, 1}, 0.055914}, {{5, 2}, 0.055914}, {{5, 3}, 0.055914}, {{6, 3}, 0.216871}, {{7, 3}, 0.216871}, {{6, 1}, 0.216871}, {{8, 3}, 0.384614}, {{8, 2}, 0.384614}, {{12, 1}, 0.125000}, {{12, 2}, 0.125000}, {{12, 3}, 0.125000}, {{13, 3}, 0.125000}, {{14, 3}, 0.125000}, {{14, 2}, 0.125000}, {{14, 1}, 0.125000}, {{13, 1}, 0.125000}, {{10, 12}, 0.375000}, {{10, 13}, 0.375000}, {{10, 14}, 0.375000}, {{11, 14}, 0.375000}, {{12, 14}, 0.375000}, {{12, 13}, 0.375000}, {{12, 12}, 0.375000}, {{11, 12}, 0.375000}, {{2, 4}, 0.138207}, {{2, 5}, 0.138207}, {{2, 6}, 0.121054}, {{3, 6}, 0.121054}, {{4, 6}, 0.101162}, {{4, 5}, 0.121054}, {{4, 4}, 0.121054}, {{3, 4}, 0.138207}, {{5, 6}, 0.131346}, {{6, 6}, 0.131346}, {{6, 5}, 0.131346}, {{6, 4}, 0.131346}, {{5, 4}, 0.131346}, {{2, 7}, 0.131346}, {{2, 8}, 0.131346}, {{3, 8}, 0.131346}, {{4, 8}, 0.131346}, {{4, 7}, 0.131346}, {{0, 10}, 0.156748}, {{0, 11}, 0.156748}, {{0, 12}, 0.686505}, {{0, 13}, 0.156748}, {{0, 14}, 0.156748}, {{7, 14}, 0.500000}, {{7, 13}, 0.500000}}
         }
     }
 };
@@ -0,0 +1,345 @@
+#pragma once
+
+#include "../board_image.h"
+#include "basic_optimized.h"
+#include "components.h"
+#include "constraint_kernels.h"
+#include "mine_counts.h"
+#include "reduction.h"
+#include "solution_info.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace solvers::anytime
+{
+
+using Clock = std::chrono::steady_clock;
+
+// configurations visited between deadline checks while enumerating
+constexpr uint64_t VISITS_PER_CHECK = 1ull << 16;
+// samples taken between deadline checks, every sampled component gets at least this many
+constexpr uint32_t SAMPLES_PER_CHECK = 64;
+
+// same loop as basic_optimized::enumerateRange, but it stops after about maxVisited
+// configurations and returns the configuration to continue from, or end if it finished
+template<constraint_kernels::Kernel kernel>
+uint64_t enumerateSome(const constraint_kernels::ConstraintBlock& block, uint64_t begin,
+    uint64_t end, uint64_t maxVisited, mine_counts::Histogram& histogram)
+{
+    uint64_t mines = begin;
+    for (uint64_t visited = 0; mines < end && visited < maxVisited; visited++)
+    {
+        int jumpBit = constraint_kernels::jumpBit<kernel>(block, mines);
+        if (jumpBit >= 0)
+        {
+            mines &= ~((1ull << jumpBit) - 1);
+            mines += 1ull << jumpBit;
+            continue;
+        }
+
+        histogram.addConfiguration(mines);
+        mines++;
+    }
+    return std::min(mines, end);
+}
+
+// enumerates every configuration of component unless the deadline passes first
+// the first VISITS_PER_CHECK configurations are always enumerated, so small components
+// are exact even when the deadline has already passed
+inline std::optional<mine_counts::Histogram> enumerateUntil(
+    const components::Component& component, Clock::time_point deadline)
+{
+    const uint32_t numCells = component.cells.size();
+    if (numCells == 0)
+        return basic_optimized::enumerateComponent<constraint_kernels::DEFAULT_KERNEL>(
+            component, 1, nullptr);
+
+    mine_counts::Histogram histogram(component.cells);
+    const constraint_kernels::ConstraintBlock block(component.constraints);
+    const uint64_t end = 1ull << numCells;
+    uint64_t mines = 0;
+    while (true)
+    {
+        mines = enumerateSome<constraint_kernels::DEFAULT_KERNEL>(
+            block, mines, end, VISITS_PER_CHECK, histogram);
+        if (mines == end)
+            return histogram;
+        if (Clock::now() >= deadline)
+            return {};
+    }
+}
+
+// Estimates the histogram of a component with sequential importance sampling
+// Each sample goes through the cells in order, assigns every cell a constraint forces,
+// and picks the others uniformly at random. A sample that ends in a valid configuration
+// after f random picks stands for 2^f configurations, so weighting it by 2^f makes the
+// sums unbiased estimates of the configuration counts
+// Samples that run into a contradiction get no weight
+class ComponentSampler
+{
+public:
+    ComponentSampler(const components::Component& component);
+
+    void sample(uint32_t numSamples, std::mt19937_64& rng);
+
+    // effective number of samples given how uneven the weights are
+    double effectiveSamples() const;
+    // empty if no sample has found a valid configuration yet
+    std::optional<mine_counts::Histogram> histogram() const;
+
+private:
+    // the weights are scaled by 2^-m_Exponent so they stay in range of a double
+    static constexpr int32_t NO_EXPONENT = INT32_MIN;
+
+    // returns false on a contradiction
+    bool assign(uint32_t cell, bool mine);
+    bool propagate();
+    void sampleOnce(std::mt19937_64& rng);
+    void addSample(int32_t randomPicks);
+
+    const components::Component& m_Component;
+    // cell -> indices of the constraints containing it
+    std::vector<std::vector<uint32_t>> m_CellConstraints;
+
+    // state of the current sample
+    std::vector<reduction::CellValue> m_Values;
+    std::vector<int32_t> m_Needed;
+    std::vector<int32_t> m_Remaining;
+    // constraints whose unknown cells are all mines or all clear
+    std::vector<uint32_t> m_Forced;
+
+    int32_t m_Exponent = NO_EXPONENT;
+    std::vector<double> m_Configurations;
+    std::vector<double> m_Hits;
+    double m_SumWeights = 0.0;
+    double m_SumSquaredWeights = 0.0;
+};
+
+inline ComponentSampler::ComponentSampler(const components::Component& component)
+    : m_Component(component),
+      m_CellConstraints(component.cells.size()),
+      m_Values(component.cells.size()),
+      m_Needed(component.constraints.size()),
+      m_Remaining(component.constraints.size()),
+      m_Configurations(component.cells.size() + 1),
+      m_Hits((component.cells.size() + 1) * component.cells.size())
+{
+    for (uint32_t c = 0; c < component.constraints.size(); c++)
+    {
+        for (uint32_t idx : component.constraints[c].indices)
+            m_CellConstraints[idx].push_back(c);
+    }
+}
+
+inline bool ComponentSampler::assign(uint32_t cell, bool mine)
+{
+    m_Values[cell] = mine ? reduction::CellValue::MINE : reduction::CellValue::CLEAR;
+    for (uint32_t c : m_CellConstraints[cell])
+    {
+        m_Remaining[c]--;
+        m_Needed[c] -= mine;
+        if (m_Needed[c] < 0 || m_Needed[c] > m_Remaining[c])
+            return false;
+        if (m_Remaining[c] > 0 && (m_Needed[c] == 0 || m_Needed[c] == m_Remaining[c]))
+            m_Forced.push_back(c);
+    }
+    return true;
+}
+
+inline bool ComponentSampler::propagate()
+{
+    while (!m_Forced.empty())
+    {
+        const uint32_t c = m_Forced.back();
+        m_Forced.pop_back();
+        // a forced constraint stays forced, any other assignment would be a contradiction
+        const bool mine = m_Needed[c] > 0;
+        for (uint32_t idx : m_Component.constraints[c].indices)
+        {
+            if (m_Values[idx] == reduction::CellValue::UNKNOWN && !assign(idx, mine))
+                return false;
+        }
+    }
+    return true;
+}
+
+inline void ComponentSampler::sampleOnce(std::mt19937_64& rng)
+{
+    std::fill(m_Values.begin(), m_Values.end(), reduction::CellValue::UNKNOWN);
+    m_Forced.clear();
+    for (uint32_t c = 0; c < m_Component.constraints.size(); c++)
+    {
+        const auto& constraint = m_Component.constraints[c];
+        m_Needed[c] = constraint.sum;
+        m_Remaining[c] = constraint.indices.size();
+        if (m_Needed[c] > m_Remaining[c])
+            return;
+        if (m_Needed[c] == 0 || m_Needed[c] == m_Remaining[c])
+            m_Forced.push_back(c);
+    }
+
+    int32_t randomPicks = 0;
+    for (uint32_t cell = 0; cell < m_Values.size(); cell++)
+    {
+        if (!propagate())
+            return;
+        if (m_Values[cell] != reduction::CellValue::UNKNOWN)
+            continue;
+        // after propagating, no constraint of an unknown cell is forced, so either value
+        // is still possible locally
+        randomPicks++;
+        if (!assign(cell, rng() & 1))
+            return;
+    }
+    // every constraint has no cells left, and assign() checked that none of them needs any mines
+    addSample(randomPicks);
+}
+
+inline void ComponentSampler::addSample(int32_t randomPicks)
+{
+    if (randomPicks > m_Exponent)
+    {
+        if (m_Exponent != NO_EXPONENT)
+        {
+            const double scale = std::ldexp(1.0, m_Exponent - randomPicks);
+            for (double& count : m_Configurations)
+                count *= scale;
+            for (double& count : m_Hits)
+                count *= scale;
+            m_SumWeights *= scale;
+            m_SumSquaredWeights *= scale * scale;
+        }
+        m_Exponent = randomPicks;
+    }
+
+    const double weight = std::ldexp(1.0, randomPicks - m_Exponent);
+    uint32_t numMines = 0;
+    for (reduction::CellValue value : m_Values)
+        numMines += value == reduction::CellValue::MINE;
+
+    const uint32_t numCells = m_Values.size();
+    m_Configurations[numMines] += weight;
+    for (uint32_t i = 0; i < numCells; i++)
+    {
+        if (m_Values[i] == reduction::CellValue::MINE)
+            m_Hits[numMines * numCells + i] += weight;
+    }
+    m_SumWeights += weight;
+    m_SumSquaredWeights += weight * weight;
+}
+
+inline void ComponentSampler::sample(uint32_t numSamples, std::mt19937_64& rng)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+        sampleOnce(rng);
+}
+
+inline double ComponentSampler::effectiveSamples() const
+{
+    if (m_SumSquaredWeights == 0.0)
+        return 0.0;
+    return m_SumWeights * m_SumWeights / m_SumSquaredWeights;
+}
+
+inline std::optional<mine_counts::Histogram> ComponentSampler::histogram() const
+{
+    if (m_SumWeights == 0.0)
+        return {};
+
+    // only the ratios between the estimates matter, so the largest one is scaled to 2^52,
+    // where a double still holds every integer exactly
+    const double largest = *std::max_element(m_Configurations.begin(), m_Configurations.end());
+    const double scale = std::ldexp(1.0, 52) / largest;
+
+    mine_counts::Histogram histogram(m_Component.cells);
+    histogram.exact = false;
+    for (size_t k = 0; k < m_Configurations.size(); k++)
+        histogram.configurations[k] = std::llround(m_Configurations[k] * scale);
+    for (size_t i = 0; i < m_Hits.size(); i++)
+        histogram.hits[i] = std::llround(m_Hits[i] * scale);
+    return histogram;
+}
+
+// Solves image exactly if that finishes before deadline
+// Enumeration gets the first half of the time, and every component that didn't finish in it,
+// or that is too large to enumerate, is sampled in the other half instead
+// The solution says whether it is exact, and estimates the error of the probabilities if not
+// Only enumeration and sampling watch the deadline, reducing the frontier and combining the
+// components are not bounded, and every component gets its first few configurations or samples
+// empty if sampling didn't find any valid configuration of some component
+inline std::optional<SolutionInfo> solveUntil(const BoardImage& image, Clock::time_point deadline)
+{
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point exactDeadline = start + (deadline - start) / 2;
+
+    const components::Frontier frontier = components::buildFrontier(image);
+    basic_optimized::ReducedFrontier reduced =
+        basic_optimized::reduceFrontier(frontier.cells, frontier.constraints);
+    basic_optimized::FrontierSolution& result = reduced.solution;
+
+    std::vector<const components::Component*> sampled;
+    for (auto& component : reduced.components)
+    {
+        // the order that makes enumeration jump the furthest also makes the sampler
+        // reach forced cells sooner
+        std::pmr::vector<uint32_t> order = components::cuthillMcKee(component);
+        std::reverse(order.begin(), order.end());
+        components::renumber(component, order);
+
+        if (component.cells.size() < basic_optimized::MAX_UNCLEARED)
+        {
+            if (auto histogram = enumerateUntil(component, exactDeadline))
+            {
+                result.histograms.push_back(std::move(histogram.value()));
+                continue;
+            }
+        }
+        sampled.push_back(&component);
+    }
+
+    std::mt19937_64 rng;
+    double probError = 0.0;
+    for (size_t i = 0; i < sampled.size(); i++)
+    {
+        // the time left is split evenly between the components left to sample
+        const Clock::time_point now = Clock::now();
+        const Clock::time_point componentDeadline =
+            now + (std::max(deadline, now) - now) / static_cast<int64_t>(sampled.size() - i);
+
+        ComponentSampler sampler(*sampled[i]);
+        do
+            sampler.sample(SAMPLES_PER_CHECK, rng);
+        while (Clock::now() < componentDeadline);
+
+        std::optional<mine_counts::Histogram> histogram = sampler.histogram();
+        if (!histogram)
+            return {};
+        result.histograms.push_back(std::move(histogram.value()));
+        // a probability estimated from n independent samples has a standard error of at most
+        // 0.5 / sqrt(n), this ignores how the mine count weights reweight the samples
+        probError = std::max(probError, 0.5 / std::sqrt(sampler.effectiveSamples()));
+    }
+
+    const uint32_t availableMines = image.numMines() - result.knownMines.size();
+    SolutionInfo solution = mine_counts::combine(
+        result.uncleared, result.histograms, frontier.outsideCells, availableMines);
+    solution.probError = probError;
+
+    solution.mines.insert(solution.mines.end(), result.knownMines.begin(), result.knownMines.end());
+    solution.clears.insert(
+        solution.clears.end(), result.knownClears.begin(), result.knownClears.end());
+
+    return {solution};
+}
+
+inline std::optional<SolutionInfo> solveWithin(const BoardImage& image, Clock::duration budget)
+{
+    return solveUntil(image, Clock::now() + budget);
+}
+
+}
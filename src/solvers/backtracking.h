@@ -0,0 +1,203 @@
+#pragma once
+
+#include "../board_image.h"
+#include "components.h"
+#include "mine_counts.h"
+#include "solution_info.h"
+
+#include <optional>
+#include <vector>
+
+namespace solvers::backtracking
+{
+
+// depth first search over the cells of a single component
+// every assignment updates the constraints touching the cell, and constraints
+// that only have one way left to be satisfied force the rest of their cells
+class ComponentSearch
+{
+public:
+    ComponentSearch(const components::Component& component);
+
+    mine_counts::Histogram run();
+
+private:
+    enum class Assignment : uint8_t
+    {
+        UNASSIGNED,
+        CLEAR,
+        MINE
+    };
+
+    struct ConstraintState
+    {
+        // number of cells in the constraint that are not assigned yet
+        uint32_t remaining;
+        // number of mines that still have to be placed in those cells
+        int32_t needed;
+    };
+
+    bool assign(uint32_t cell, Assignment value);
+    bool propagate();
+    void undo(size_t trailSize);
+    void search(uint32_t nextCell);
+
+    const components::Component& m_Component;
+    mine_counts::Histogram m_Histogram;
+
+    // constraints each cell is part of
+    std::vector<StaticVector<uint32_t, 8>> m_CellConstraints;
+    std::vector<ConstraintState> m_Constraints;
+    std::vector<Assignment> m_Assignments;
+    // assigned cells, in the order they were assigned
+    std::vector<uint32_t> m_Trail;
+    // constraints whose cells might be forced
+    std::vector<uint32_t> m_Pending;
+    std::vector<uint32_t> m_MineCells;
+};
+
+inline ComponentSearch::ComponentSearch(const components::Component& component)
+    : m_Component(component),
+      m_Histogram(component.cells),
+      m_CellConstraints(component.cells.size()),
+      m_Assignments(component.cells.size(), Assignment::UNASSIGNED)
+{
+    for (uint32_t i = 0; i < component.constraints.size(); i++)
+    {
+        const auto& constraint = component.constraints[i];
+        m_Constraints.push_back(
+            {static_cast<uint32_t>(constraint.indices.size()), static_cast<int32_t>(constraint.sum)});
+        for (uint32_t cell : constraint.indices)
+            m_CellConstraints[cell].push_back(i);
+    }
+}
+
+inline mine_counts::Histogram ComponentSearch::run()
+{
+    for (const auto& state : m_Constraints)
+    {
+        // unsatisfiable before anything is assigned
+        if (state.needed < 0 || state.needed > static_cast<int32_t>(state.remaining))
+            return m_Histogram;
+    }
+
+    for (uint32_t i = 0; i < m_Constraints.size(); i++)
+        m_Pending.push_back(i);
+    if (propagate())
+        search(0);
+    return m_Histogram;
+}
+
+// returns false as soon as a constraint can no longer be satisfied
+inline bool ComponentSearch::assign(uint32_t cell, Assignment value)
+{
+    m_Assignments[cell] = value;
+    m_Trail.push_back(cell);
+
+    bool valid = true;
+    for (uint32_t constraintIdx : m_CellConstraints[cell])
+    {
+        ConstraintState& state = m_Constraints[constraintIdx];
+        state.remaining--;
+        state.needed -= value == Assignment::MINE;
+        if (state.needed < 0 || state.needed > static_cast<int32_t>(state.remaining))
+            valid = false;
+        else if (state.remaining > 0
+            && (state.needed == 0 || state.needed == static_cast<int32_t>(state.remaining)))
+            m_Pending.push_back(constraintIdx);
+    }
+    return valid;
+}
+
+// assign every cell that is forced by a pending constraint
+// all remaining cells are clear if no more mines are needed
+// and all remaining cells are mines if every one of them is needed
+inline bool ComponentSearch::propagate()
+{
+    while (!m_Pending.empty())
+    {
+        uint32_t constraintIdx = m_Pending.back();
+        m_Pending.pop_back();
+
+        const ConstraintState& state = m_Constraints[constraintIdx];
+        if (state.remaining == 0)
+            continue;
+
+        Assignment forced;
+        if (state.needed == 0)
+            forced = Assignment::CLEAR;
+        else if (state.needed == static_cast<int32_t>(state.remaining))
+            forced = Assignment::MINE;
+        else
+            continue;
+
+        for (uint32_t cell : m_Component.constraints[constraintIdx].indices)
+        {
+            if (m_Assignments[cell] != Assignment::UNASSIGNED)
+                continue;
+            if (!assign(cell, forced))
+            {
+                m_Pending.clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline void ComponentSearch::undo(size_t trailSize)
+{
+    while (m_Trail.size() > trailSize)
+    {
+        uint32_t cell = m_Trail.back();
+        m_Trail.pop_back();
+        for (uint32_t constraintIdx : m_CellConstraints[cell])
+        {
+            ConstraintState& state = m_Constraints[constraintIdx];
+            state.remaining++;
+            state.needed += m_Assignments[cell] == Assignment::MINE;
+        }
+        m_Assignments[cell] = Assignment::UNASSIGNED;
+    }
+}
+
+inline void ComponentSearch::search(uint32_t nextCell)
+{
+    while (nextCell < m_Assignments.size() && m_Assignments[nextCell] != Assignment::UNASSIGNED)
+        nextCell++;
+
+    if (nextCell == m_Assignments.size())
+    {
+        // every constraint has remaining == 0 and needed == 0 here,
+        // otherwise an assignment would have failed
+        m_MineCells.clear();
+        for (uint32_t i = 0; i < m_Assignments.size(); i++)
+            if (m_Assignments[i] == Assignment::MINE)
+                m_MineCells.push_back(i);
+        m_Histogram.addConfiguration(m_MineCells);
+        return;
+    }
+
+    const size_t trailSize = m_Trail.size();
+    for (Assignment value : {Assignment::CLEAR, Assignment::MINE})
+    {
+        if (assign(nextCell, value) && propagate())
+            search(nextCell + 1);
+        m_Pending.clear();
+        undo(trailSize);
+    }
+}
+
+inline std::optional<SolutionInfo> solve(const BoardImage& image)
+{
+    const components::Frontier frontier = components::buildFrontier(image);
+
+    std::vector<mine_counts::Histogram> histograms;
+    for (const auto& component : components::split(frontier.cells.size(), frontier.constraints))
+        histograms.push_back(ComponentSearch(component).run());
+
+    return {mine_counts::combine(
+        frontier.cells, histograms, frontier.outsideCells, image.numMines())};
+}
+
+}
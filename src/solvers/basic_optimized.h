@@ -2,233 +2,399 @@
 
 #include "../board_image.h"
 #include "../util/bitset.h"
-#include "brute_force.h"
+#include "../util/grid_index.h"
+#include "../util/parallel.h"
+#include "component_cache.h"
+#include "components.h"
+#include "constraint_kernels.h"
+#include "meet_in_the_middle.h"
+#include "mine_counts.h"
+#include "reduction.h"
 #include "solution_info.h"
+#include "solver_context.h"
 
+#include <algorithm>
 #include <bit>
-#include <unordered_map>
-#include <unordered_set>
+#include <memory_resource>
+#include <span>
+#include <thread>
 
 namespace solvers::basic_optimized
 {
 
-inline std::optional<SolutionInfo> solve(const BoardImage& image)
+// components with fewer cells are always enumerated on a single thread
+constexpr uint32_t MIN_PARALLEL_CELLS = 24;
+// components with this many cells don't fit in a 64 bit configuration
+constexpr uint32_t MAX_UNCLEARED = 64;
+// number of chunks per thread the configuration space is split into for load balancing
+constexpr uint32_t CHUNKS_PER_THREAD = 16;
+
+// how frontier cells are numbered before enumerating a component
+enum class Ordering
+{
+    // the order numberedCells() finds them in
+    FRONTIER,
+    // reversed Cuthill-McKee, so cells found first get the highest bits
+    // the constraints around the start of the search then have high lowest bits, and their
+    // jumps skip large parts of the configuration space
+    REVERSE_CUTHILL_MCKEE
+};
+
+struct Statistics
+{
+    // configurations the enumeration loop looked at, including the ones it jumped from
+    uint64_t visitedConfigurations = 0;
+};
+
+// loop through the mine configurations in [begin, end)
+// bits of the number represent whether a cell is a mine or clear
+// returns the number of configurations visited
+template<constraint_kernels::Kernel kernel>
+uint64_t enumerateRange(const constraint_kernels::ConstraintBlock& block, uint64_t begin,
+    uint64_t end, mine_counts::Histogram& histogram)
+{
+    uint64_t visited = 0;
+    for (uint64_t mines = begin; mines < end;)
+    {
+        visited++;
+        // skip invalid configurations
+        // If a constraint is unmatched, we don't need to check any of the
+        // configurations that don't change the lowest index bit in that constraint
+        // so we can skip all configurations that don't change the lowest bit in the constraint
+        // the kernel keeps track of the constraint with the highest lowest index bit
+        int jumpBit = constraint_kernels::jumpBit<kernel>(block, mines);
+        if (jumpBit >= 0)
+        {
+            // skip configurations that can't possibly satisfy the constraints
+            mines &= ~((1ull << jumpBit) - 1);
+            mines += 1ull << jumpBit;
+            continue;
+        }
+
+        // bucket by mine count, the weights are applied once per mine count when combining
+        histogram.addConfiguration(mines);
+
+        mines++;
+    }
+    return visited;
+}
+
+// loop through all possible mine configurations of a single component
+// large components are split into chunks by the top bits of the configuration
+// each thread accumulates into its own histogram, which only contains integer counts
+// so merging them gives exactly the same result as a single thread
+template<constraint_kernels::Kernel kernel>
+mine_counts::Histogram enumerateComponent(const components::Component& component,
+    uint32_t numThreads, Statistics* statistics,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
-    constexpr uint32_t MAX_UNCLEARED = 64;
+    const uint32_t numCells = component.cells.size();
+    mine_counts::Histogram histogram(component.cells, resource);
 
-    std::unordered_map<Point, bool, PointHash> earlySolves;
-    std::unordered_set<Point, PointHash> earlySolvedNumberCells;
-    uint32_t earlySolvedMines = 0;
+    if (numCells == 0)
+    {
+        // only constraints without any unknown cells, which all have to be already satisfied
+        bool valid = true;
+        for (const auto& constraint : component.constraints)
+            valid &= constraint.sum == 0;
+        histogram.configurations[0] = valid;
+        return histogram;
+    }
 
-    // solve trivially recognizable cases
-    // guaranteed mine
-    // ..O
-    // .1.
-    // ...
+    const constraint_kernels::ConstraintBlock block(component.constraints, resource);
 
-    // X = mine
-    // guaranteed clear
-    // ..X
-    // .1O
-    // ..O
-    while (true)
+    if (numThreads <= 1 || numCells < MIN_PARALLEL_CELLS)
     {
-        bool foundSolve = false;
-        for (const auto& cell : image.numberedCells())
+        uint64_t visited = enumerateRange<kernel>(block, 0, 1ull << numCells, histogram);
+        if (statistics)
+            statistics->visitedConfigurations += visited;
+        return histogram;
+    }
+
+    // a jump can cross chunk boundaries, but only over configurations that are invalid
+    // anyway, so every chunk can stop at its own end
+    const uint32_t chunkBits =
+        std::min<uint32_t>(std::bit_width(numThreads * CHUNKS_PER_THREAD - 1), numCells);
+    const uint32_t chunkShift = numCells - chunkBits;
+    std::vector<mine_counts::Histogram> threadHistograms(numThreads, histogram);
+    std::vector<uint64_t> threadVisited(numThreads);
+    parallelFor(1ull << chunkBits, numThreads,
+        [&](uint32_t threadIdx, uint64_t chunk)
         {
-            uint32_t knownMines = 0;
-            uint32_t knownClears = 0;
-            for (Point neighbor : cell.unclearedNeighbors)
-            {
-                if (earlySolves.count(neighbor) > 0)
-                {
-                    if (earlySolves.at(neighbor))
-                        knownMines++;
-                    else
-                        knownClears++;
-                }
-            }
+            threadVisited[threadIdx] += enumerateRange<kernel>(block, chunk << chunkShift,
+                (chunk + 1) << chunkShift, threadHistograms[threadIdx]);
+        });
 
-            // all cells that are not already known are mines
-            if (cell.adjacentMines == cell.unclearedNeighbors.size() - knownClears)
-            {
-                earlySolvedNumberCells.insert(cell.location);
-                for (Point neighbor : cell.unclearedNeighbors)
-                {
-                    if (earlySolves.count(neighbor) == 0)
-                    {
-                        foundSolve = true;
-                        earlySolves.insert({neighbor, true});
-                        earlySolvedMines++;
-                    }
-                }
-            }
-            // all cells that are not already known are clear
-            else if (cell.adjacentMines == knownMines)
-            {
-                earlySolvedNumberCells.insert(cell.location);
-                for (Point neighbor : cell.unclearedNeighbors)
-                {
-                    if (earlySolves.count(neighbor) == 0)
-                    {
-                        foundSolve = true;
-                        earlySolves.insert({neighbor, false});
-                    }
-                }
-            }
-        }
+    for (const auto& threadHistogram : threadHistograms)
+        histogram += threadHistogram;
+    if (statistics)
+    {
+        for (uint64_t visited : threadVisited)
+            statistics->visitedConfigurations += visited;
+    }
+    return histogram;
+}
+
+// what solving the constraints over a set of frontier cells gives
+struct FrontierSolution
+{
+    std::pmr::vector<Point> knownMines;
+    std::pmr::vector<Point> knownClears;
+    // cells that could still be either, the cells of the histograms index into this
+    std::pmr::vector<Point> uncleared;
+    std::pmr::vector<mine_counts::Histogram> histograms;
 
-        if (!foundSolve)
-            break;
+    FrontierSolution(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : knownMines(resource), knownClears(resource), uncleared(resource), histograms(resource)
+    {
     }
+};
+
+// a frontier after everything the reducer can deduce has been removed from it
+struct ReducedFrontier
+{
+    // the histograms are left empty
+    FrontierSolution solution;
+    // components of the cells that are still unknown, the cells index into solution.uncleared
+    std::pmr::vector<components::Component> components;
+};
 
-    // bookkeeping information
-    // each unknown cell is assigned an index
-    std::unordered_map<Point, uint32_t, PointHash> unclearedIndices;
-    std::vector<Point> uncleared;
-    std::vector<brute_force::Constraint> constraints;
+// constraints index into frontier
+inline ReducedFrontier reduceFrontier(std::span<const Point> frontier,
+    std::span<const components::FrontierConstraint> frontierConstraints,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    // solve everything that can be deduced from one or two constraints at a time
+    reduction::Reducer reducer(frontier.size(), frontierConstraints, resource);
+    reducer.run();
+    const std::pmr::vector<reduction::CellValue>& values = reducer.values();
+
+    ReducedFrontier result = {
+        FrontierSolution(resource), std::pmr::vector<components::Component>(resource)};
+    FrontierSolution& solution = result.solution;
 
-    for (const auto& cell : image.numberedCells())
+    // the cells that are still unknown get new indices for enumeration
+    std::pmr::vector<uint32_t> unclearedIndices(frontier.size(), resource);
+    for (uint32_t i = 0; i < frontier.size(); i++)
     {
-        if (earlySolvedNumberCells.count(cell.location) > 0)
-            continue;
-        brute_force::Constraint constraint = {};
-        uint32_t knownMines = 0;
-        for (auto neighbor : cell.unclearedNeighbors)
+        if (values[i] == reduction::CellValue::MINE)
+            solution.knownMines.push_back(frontier[i]);
+        else if (values[i] == reduction::CellValue::CLEAR)
+            solution.knownClears.push_back(frontier[i]);
+        else
         {
-            if (earlySolves.count(neighbor) > 0)
-            {
-                if (earlySolves.at(neighbor))
-                    knownMines++;
-                continue;
-            }
-            uint32_t idx;
-            if (unclearedIndices.count(neighbor) == 0)
-            {
-                idx = uncleared.size();
-                uncleared.push_back(neighbor);
-                unclearedIndices.insert({neighbor, idx});
-            }
-            else
-            {
-                idx = unclearedIndices.at(neighbor);
-            }
-            constraint.addIndex(idx);
+            unclearedIndices[i] = solution.uncleared.size();
+            solution.uncleared.push_back(frontier[i]);
         }
-        constraint.sum = cell.adjacentMines - knownMines;
-        constraints.push_back(constraint);
     }
 
-    if (uncleared.size() >= MAX_UNCLEARED)
-        return {};
+    std::pmr::vector<components::FrontierConstraint> constraints =
+        reducer.remainingConstraints();
+    for (auto& constraint : constraints)
+    {
+        for (uint32_t& idx : constraint.indices)
+            idx = unclearedIndices[idx];
+    }
 
-    uint64_t alwaysMines = (1ull << uncleared.size()) - 1;
-    uint64_t alwaysClear = (1ull << uncleared.size()) - 1;
-    SolutionInfo solution = {};
-    solution.initMineProbs(uncleared);
-
-    // loop through all possible mine configurations
-    // bits of the number represent whether a cell is a mine or clear
-    double totalWeight = 0.0;
-    const uint32_t outsideMineCells = image.width() * image.height() - uncleared.size()
-        - earlySolves.size() - image.zeroCells().size() - image.numberedCells().size();
-    const uint32_t availableMines = image.numMines() - earlySolvedMines;
-    for (uint64_t mines = 0; mines < 1ull << uncleared.size();)
+    // cells that don't share any constraints can be enumerated independently,
+    // which turns 2^(a + b) configurations into 2^a + 2^b
+    result.components = components::split(solution.uncleared.size(), constraints, resource);
+    return result;
+}
+
+// constraints index into frontier
+// components with meet_in_the_middle::MIN_CELLS or more cells are solved in two halves
+// even when numThreads would let enumerateComponent split them up, enumerating a 24-40 cell
+// component on one thread takes 14-250 times as long as meet in the middle does
+// empty if a component is too large to enumerate
+// the scratch memory and the solution come from resource
+template<constraint_kernels::Kernel kernel>
+std::optional<FrontierSolution> solveFrontier(std::span<const Point> frontier,
+    std::span<const components::FrontierConstraint> frontierConstraints, uint32_t numThreads,
+    Ordering ordering, Statistics* statistics, component_cache::ComponentCache* cache,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    ReducedFrontier reduced = reduceFrontier(frontier, frontierConstraints, resource);
+    FrontierSolution& result = reduced.solution;
+
+    for (auto& component : reduced.components)
     {
-        int jumpBit = 0;
-        bool valid = true;
-        // skip invalid configurations
-        // If a constraint is unmatched, we don't need to check any of the
-        // configurations that don't change the lowest index bit in that constraint
-        // so we can skip all configurations that don't change the lowest bit in the constraint
-        for (const auto& constraint : constraints)
+        if (component.cells.size() > meet_in_the_middle::MAX_CELLS)
+            return {};
+        if (ordering == Ordering::REVERSE_CUTHILL_MCKEE)
         {
-            // keep track of the constraint with the highest lowest index bit
-            if (std::popcount(constraint.mask & mines) != constraint.sum)
+            std::pmr::vector<uint32_t> order = components::cuthillMcKee(component, resource);
+            std::reverse(order.begin(), order.end());
+            components::renumber(component, order);
+        }
+
+        component_cache::CanonicalForm form(resource);
+        if (cache)
+        {
+            form = component_cache::canonicalize(component, result.uncleared, resource);
+            if (auto histogram = cache->find(component, form, resource))
             {
-                valid = false;
-                jumpBit = std::max(jumpBit, std::countr_zero(constraint.mask));
+                result.histograms.push_back(std::move(histogram.value()));
+                continue;
             }
         }
-        if (!valid)
+
+        std::optional<mine_counts::Histogram> histogram;
+        if (component.cells.size() >= meet_in_the_middle::MIN_CELLS)
         {
-            // skip configurations that can't possibly satisfy the constraints
-            mines &= ~((1ull << jumpBit) - 1);
-            mines += 1ull << jumpBit;
-            continue;
+            histogram = meet_in_the_middle::solve<kernel>(component, numThreads,
+                statistics ? &statistics->visitedConfigurations : nullptr, resource);
         }
-
-        solution.numValidSolutions++;
-        // keep track of which cells were always mines/always clear
-        alwaysMines &= mines;
-        alwaysClear &= ~mines;
-
-        // Adjust weight for the current mine configuration based on
-        // the number of valid ways other mines can be configured
-        // weight is proportional to N choose M, where N is
-        // the number of other squares that mines can be in
-        // and M is the number of mines that can be in those squares
-        double currWeight = 1.0;
-        for (uint32_t i = 0; i < std::popcount(mines); i++)
+        if (!histogram)
         {
-            if (outsideMineCells + 1 + i - availableMines <= 0)
-                continue;
-            currWeight *= static_cast<double>(availableMines - i);
-            currWeight /= static_cast<double>(outsideMineCells + 1 + i - availableMines);
+            if (component.cells.size() >= MAX_UNCLEARED)
+                return {};
+            histogram = enumerateComponent<kernel>(component, numThreads, statistics, resource);
         }
+        result.histograms.push_back(std::move(histogram.value()));
+        if (cache)
+            cache->insert(form, result.histograms.back());
+    }
 
-        totalWeight += currWeight;
+    return std::move(result);
+}
 
-        double currOutsideMineProb = static_cast<double>(availableMines - std::popcount(mines))
-            / static_cast<double>(outsideMineCells);
-        solution.outsideMineProb += currWeight * currOutsideMineProb;
+// writes the solution into solution, reusing the memory it already has
+// all of the scratch memory comes from resource, and frontierIndices, which is overwritten
+// returns false if a component is too large to enumerate
+template<constraint_kernels::Kernel kernel>
+bool solveImage(const BoardImage& image, uint32_t numThreads, Ordering ordering,
+    Statistics* statistics, component_cache::ComponentCache* cache,
+    std::pmr::memory_resource* resource, GridIndex& frontierIndices, SolutionInfo& solution)
+{
+    components::Frontier frontier(resource);
+    components::buildFrontier(image, frontierIndices, frontier);
 
-        uint32_t minesCopy = mines;
-        while (minesCopy > 0)
-        {
-            uint32_t mineIdx = std::countr_zero(minesCopy);
-            solution.mineProbs[mineIdx].prob += currWeight;
+    std::optional<FrontierSolution> result = solveFrontier<kernel>(frontier.cells,
+        frontier.constraints, numThreads, ordering, statistics, cache, resource);
+    if (!result)
+        return false;
 
-            minesCopy &= minesCopy - 1;
-        }
+    const uint32_t availableMines = image.numMines() - result->knownMines.size();
+    mine_counts::combine(result->uncleared, result->histograms, frontier.outsideCells,
+        availableMines, solution, resource);
 
-        mines++;
-    }
+    solution.mines.insert(
+        solution.mines.end(), result->knownMines.begin(), result->knownMines.end());
+    solution.clears.insert(
+        solution.clears.end(), result->knownClears.begin(), result->knownClears.end());
+    return true;
+}
 
-    // convert back from indices to squares
-    while (alwaysMines)
-    {
-        int mine = poplsb(alwaysMines);
-        solution.mines.push_back(uncleared[mine]);
-    }
+template<constraint_kernels::Kernel kernel>
+std::optional<SolutionInfo> solveWithKernel(const BoardImage& image, uint32_t numThreads = 1,
+    Ordering ordering = Ordering::REVERSE_CUTHILL_MCKEE, Statistics* statistics = nullptr,
+    component_cache::ComponentCache* cache = nullptr)
+{
+    SolutionInfo solution = {};
+    GridIndex frontierIndices;
+    if (!solveImage<kernel>(image, numThreads, ordering, statistics, cache,
+            std::pmr::get_default_resource(), frontierIndices, solution))
+        return {};
+    return {std::move(solution)};
+}
 
-    while (alwaysClear)
-    {
-        int clear = poplsb(alwaysClear);
-        solution.clears.push_back(uncleared[clear]);
-    }
+// solves with all of the scratch memory coming from context, results are identical to solve()
+// writes into solution, so solving into the same SolutionInfo every time reuses its memory too
+// Once the context's buffer and solution are large enough, this doesn't allocate from the heap,
+// unless a component misses in the cache and is inserted
+// returns false if a component is too large to enumerate
+inline bool solveInContext(const BoardImage& image, SolverContext& context,
+    SolutionInfo& solution, component_cache::ComponentCache* cache = nullptr)
+{
+    context.reset();
+    return solveImage<constraint_kernels::DEFAULT_KERNEL>(image, 1,
+        Ordering::REVERSE_CUTHILL_MCKEE, nullptr, cache, context.resource(), context.gridIndex(),
+        solution);
+}
+
+inline std::optional<SolutionInfo> solve(const BoardImage& image)
+{
+    return solveWithKernel<constraint_kernels::DEFAULT_KERNEL>(image);
+}
+
+// enumerates large components on numThreads threads, results are identical to solve()
+inline std::optional<SolutionInfo> solveParallel(
+    const BoardImage& image, uint32_t numThreads = std::thread::hardware_concurrency())
+{
+    return solveWithKernel<constraint_kernels::DEFAULT_KERNEL>(image, numThreads);
+}
+
+// looks up every component in cache before enumerating it, results are identical to solve()
+inline std::optional<SolutionInfo> solveCached(
+    const BoardImage& image, component_cache::ComponentCache& cache)
+{
+    return solveWithKernel<constraint_kernels::DEFAULT_KERNEL>(
+        image, 1, Ordering::REVERSE_CUTHILL_MCKEE, nullptr, &cache);
+}
+
+// Solves positions one after another in the same SolverContext, and with a component cache
+// shared between all of them, so components that come up again in later positions aren't
+// enumerated again. Results are identical to solve()
+class ReusableSolver
+{
+public:
+    ReusableSolver(size_t cacheCapacity = component_cache::ComponentCache::DEFAULT_CAPACITY);
+
+    std::optional<SolutionInfo> operator()(const BoardImage& image);
+    // solving into the same solutions again reuses their memory
+    uint32_t solveBatch(std::span<const BoardImage> images, std::span<SolutionInfo> solutions);
+
+    const SolverContext& context() const;
+    const component_cache::ComponentCache& cache() const;
+
+private:
+    SolverContext m_Context;
+    component_cache::ComponentCache m_Cache;
+};
 
-    for (auto [location, isMine] : earlySolves)
+inline ReusableSolver::ReusableSolver(size_t cacheCapacity)
+    : m_Cache(cacheCapacity)
+{
+}
+
+inline std::optional<SolutionInfo> ReusableSolver::operator()(const BoardImage& image)
+{
+    SolutionInfo solution = {};
+    if (!solveInContext(image, m_Context, solution, &m_Cache))
+        return {};
+    return {std::move(solution)};
+}
+
+inline uint32_t ReusableSolver::solveBatch(
+    std::span<const BoardImage> images, std::span<SolutionInfo> solutions)
+{
+    uint32_t numSolved = 0;
+    for (size_t i = 0; i < images.size(); i++)
     {
-        if (isMine)
-            solution.mines.push_back(location);
+        if (solveInContext(images[i], m_Context, solutions[i], &m_Cache))
+            numSolved++;
         else
-            solution.clears.push_back(location);
+            solutions[i] = {};
     }
+    return numSolved;
+}
 
-    const auto remove = [&](const SolutionInfo::MineProb& mineProb)
-    {
-        return solution.isClear(mineProb.point) || solution.isMine(mineProb.point);
-    };
-    solution.mineProbs.erase(
-        std::remove_if(solution.mineProbs.begin(), solution.mineProbs.end(), remove),
-        solution.mineProbs.end());
+inline const SolverContext& ReusableSolver::context() const
+{
+    return m_Context;
+}
 
-    solution.outsideMineProb /= totalWeight;
-    for (auto& mineProb : solution.mineProbs)
-        mineProb.prob /= totalWeight;
+inline const component_cache::ComponentCache& ReusableSolver::cache() const
+{
+    return m_Cache;
+}
 
-    return {solution};
+// solves images[i] into solutions[i] with one ReusableSolver
+// positions that can't be solved get an empty SolutionInfo, returns the number that were solved
+inline uint32_t solveBatch(std::span<const BoardImage> images, std::span<SolutionInfo> solutions)
+{
+    return ReusableSolver().solveBatch(images, solutions);
 }
 
 }
@@ -2,10 +2,16 @@
 
 #include "../board_image.h"
 #include "../util/bitset.h"
+#include "../util/static_vector.h"
+#include "components.h"
+#include "mine_counts.h"
 #include "solution_info.h"
 
 #include <bit>
-#include <unordered_map>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace solvers::brute_force
 {
@@ -22,53 +28,18 @@ struct Constraint
     }
 };
 
-inline std::optional<SolutionInfo> solve(const BoardImage& image)
+enum class Enumeration
 {
-    constexpr uint32_t MAX_UNCLEARED = 35;
-
-    // bookkeeping information
-    // each unknown cell is assigned an index
-    std::unordered_map<Point, uint32_t, PointHash> unclearedIndices;
-    std::vector<Point> uncleared;
-    std::vector<Constraint> constraints;
-
-    for (const auto& cell : image.numberedCells())
-    {
-        Constraint constraint = {};
-        constraint.sum = cell.adjacentMines;
-        for (auto neighbor : cell.unclearedNeighbors)
-        {
-            uint32_t idx;
-            if (unclearedIndices.count(neighbor) == 0)
-            {
-                idx = uncleared.size();
-                uncleared.push_back(neighbor);
-                unclearedIndices.insert({neighbor, idx});
-            }
-            else
-            {
-                idx = unclearedIndices.at(neighbor);
-            }
-            constraint.addIndex(idx);
-        }
-        constraints.push_back(constraint);
-    }
-
-    // avoid trying to brute force with too large of a state space
-    if (uncleared.size() >= MAX_UNCLEARED)
-        return {};
+    BINARY,
+    GRAY_CODE
+};
 
-    uint64_t alwaysMines = (1ull << uncleared.size()) - 1;
-    uint64_t alwaysClear = (1ull << uncleared.size()) - 1;
-    SolutionInfo solution = {};
-    solution.initMineProbs(uncleared);
-
-    // loop through all possible mine configurations
-    // bits of the number represent whether a cell is a mine or clear
-    double totalWeight = 0.0;
-    const uint32_t outsideMineCells = image.width() * image.height() - uncleared.size()
-        - image.zeroCells().size() - image.numberedCells().size();
-    for (uint64_t mines = 0; mines < 1ull << uncleared.size(); mines++)
+// loop through all possible mine configurations
+// bits of the number represent whether a cell is a mine or clear
+inline void enumerateBinary(
+    uint32_t numCells, const std::vector<Constraint>& constraints, mine_counts::Histogram& histogram)
+{
+    for (uint64_t mines = 0; mines < 1ull << numCells; mines++)
     {
         bool valid = true;
         for (const auto& constraint : constraints)
@@ -83,67 +54,104 @@ inline std::optional<SolutionInfo> solve(const BoardImage& image)
         if (!valid)
             continue;
 
-        solution.numValidSolutions++;
-        // keep track of which cells were always mines/always clear
-        alwaysMines &= mines;
-        alwaysClear &= ~mines;
-
-        // Adjust weight for the current mine configuration based on
-        // the number of valid ways other mines can be configured
-        // weight is proportional to N choose M, where N is
-        // the number of other squares that mines can be in
-        // and M is the number of mines that can be in those squares
-        double currWeight = 1.0;
-        for (uint32_t i = 0; i < std::popcount(mines); i++)
-        {
-            if (outsideMineCells + 1 + i - image.numMines() <= 0)
-                continue;
-            currWeight *= static_cast<double>(image.numMines() - i);
-            currWeight /= static_cast<double>(outsideMineCells + 1 + i - image.numMines());
-        }
+        // bucket by mine count, the weights are applied once per mine count at the end
+        histogram.addConfiguration(mines);
+    }
+}
 
-        totalWeight += currWeight;
+// loop through all possible mine configurations in gray code order
+// consecutive configurations differ in exactly one cell, so only the constraints
+// touching that cell need their sums updated instead of recounting every constraint
+inline void enumerateGrayCode(
+    uint32_t numCells, const std::vector<Constraint>& constraints, mine_counts::Histogram& histogram)
+{
+    // constraints each cell is part of
+    std::vector<StaticVector<uint32_t, 8>> cellConstraints(numCells);
+    for (uint32_t i = 0; i < constraints.size(); i++)
+    {
+        uint64_t mask = constraints[i].mask;
+        while (mask)
+            cellConstraints[poplsb(mask)].push_back(i);
+    }
 
-        double currOutsideMineProb = static_cast<double>(image.numMines() - std::popcount(mines))
-            / static_cast<double>(outsideMineCells);
-        solution.outsideMineProb += currWeight * currOutsideMineProb;
+    // running number of mines each constraint still needs, satisfied at 0
+    std::vector<int32_t> needed;
+    uint32_t unsatisfied = 0;
+    for (const auto& constraint : constraints)
+    {
+        needed.push_back(constraint.sum);
+        unsatisfied += constraint.sum != 0;
+    }
 
-        uint32_t minesCopy = mines;
-        while (minesCopy > 0)
-        {
-            uint32_t mineIdx = std::countr_zero(minesCopy);
-            solution.mineProbs[mineIdx].prob += currWeight;
+    uint64_t mines = 0;
+    if (unsatisfied == 0)
+        histogram.addConfiguration(mines);
+
+    for (uint64_t step = 1; step < 1ull << numCells; step++)
+    {
+        // the nth gray code flips the lowest set bit of n
+        const uint32_t cell = std::countr_zero(step);
+        mines ^= 1ull << cell;
+        const int32_t delta = (mines >> cell) & 1 ? 1 : -1;
 
-            minesCopy &= minesCopy - 1;
+        for (uint32_t constraintIdx : cellConstraints[cell])
+        {
+            int32_t& curr = needed[constraintIdx];
+            unsatisfied -= curr != 0;
+            curr -= delta;
+            unsatisfied += curr != 0;
         }
-    }
 
-    // convert back from indices to squares
-    while (alwaysMines)
-    {
-        int mine = poplsb(alwaysMines);
-        solution.mines.push_back(uncleared[mine]);
+        if (unsatisfied == 0)
+            histogram.addConfiguration(mines);
     }
+}
+
+inline std::optional<SolutionInfo> solveWith(const BoardImage& image, Enumeration enumeration)
+{
+    constexpr uint32_t MAX_UNCLEARED = 35;
+
+    const components::Frontier frontier = components::buildFrontier(image);
+    const uint32_t numCells = frontier.cells.size();
+
+    // avoid trying to brute force with too large of a state space
+    if (numCells >= MAX_UNCLEARED)
+        return {};
 
-    while (alwaysClear)
+    std::vector<Constraint> constraints;
+    for (const auto& frontierConstraint : frontier.constraints)
     {
-        int clear = poplsb(alwaysClear);
-        solution.clears.push_back(uncleared[clear]);
+        Constraint constraint = {};
+        constraint.sum = frontierConstraint.sum;
+        for (uint32_t idx : frontierConstraint.indices)
+            constraint.addIndex(idx);
+        constraints.push_back(constraint);
     }
 
-    const auto remove = [&](const SolutionInfo::MineProb& mineProb)
-    {
-        return solution.isClear(mineProb.point) || solution.isMine(mineProb.point);
-    };
-    solution.mineProbs.erase(
-        std::remove_if(solution.mineProbs.begin(), solution.mineProbs.end(), remove),
-        solution.mineProbs.end());
+    std::vector<uint32_t> cells(numCells);
+    std::iota(cells.begin(), cells.end(), 0);
+    mine_counts::Histogram histogram(cells);
+
+    if (enumeration == Enumeration::GRAY_CODE)
+        enumerateGrayCode(numCells, constraints, histogram);
+    else
+        enumerateBinary(numCells, constraints, histogram);
 
-    solution.outsideMineProb /= totalWeight;
-    for (auto& mineProb : solution.mineProbs)
-        mineProb.prob /= totalWeight;
+    SolutionInfo solution = mine_counts::combine(
+        frontier.cells, std::span(&histogram, 1), frontier.outsideCells, image.numMines());
 
     return {solution};
 }
 
+inline std::optional<SolutionInfo> solve(const BoardImage& image)
+{
+    return solveWith(image, Enumeration::GRAY_CODE);
+}
+
+// plain increasing order, kept as the simplest possible reference
+inline std::optional<SolutionInfo> solveBinary(const BoardImage& image)
+{
+    return solveWith(image, Enumeration::BINARY);
+}
+
 }
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "../types.h"
+#include "components.h"
+#include "mine_counts.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace solvers::component_cache
+{
+
+// A component's constraint structure, independent of where it is on the board
+// The cells are translated so the lowest coordinates are 0, and of the 8 rotations and
+// reflections the one with the lexicographically smallest encoding is used, so the same shape
+// gives the same key anywhere on any board
+struct CanonicalForm
+{
+    // cell coordinates in canonical order, then every constraint as its size,
+    // canonical cell indices and sum
+    std::pmr::vector<uint32_t> key;
+    // order[i] = index within the component of the cell with canonical index i
+    std::pmr::vector<uint32_t> order;
+
+    CanonicalForm(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : key(resource), order(resource)
+    {
+    }
+};
+
+// positions[i] is the location of frontier index i
+inline CanonicalForm canonicalize(const components::Component& component,
+    std::span<const Point> positions,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    const uint32_t numCells = component.cells.size();
+
+    // (x, y) -> (sx * x, sy * y), swapped if transpose
+    struct Symmetry
+    {
+        int32_t sx;
+        int32_t sy;
+        bool transpose;
+    };
+    constexpr std::array<Symmetry, 8> SYMMETRIES = {{
+        {1, 1, false}, {-1, 1, false}, {1, -1, false}, {-1, -1, false},
+        {1, 1, true}, {-1, 1, true}, {1, -1, true}, {-1, -1, true},
+    }};
+
+    CanonicalForm best(resource);
+    std::pmr::vector<std::pair<int32_t, int32_t>> transformed(numCells, resource);
+    std::pmr::vector<uint32_t> order(numCells, resource);
+    std::pmr::vector<uint32_t> ranks(numCells, resource);
+    std::pmr::vector<std::pmr::vector<uint32_t>> encodedConstraints(
+        component.constraints.size(), resource);
+    std::pmr::vector<const std::pmr::vector<uint32_t>*> sortedConstraints(resource);
+    std::pmr::vector<uint32_t> key(resource);
+
+    for (const Symmetry& symmetry : SYMMETRIES)
+    {
+        int32_t minX = INT32_MAX;
+        int32_t minY = INT32_MAX;
+        for (uint32_t i = 0; i < numCells; i++)
+        {
+            const Point& point = positions[component.cells[i]];
+            int32_t x = symmetry.sx * static_cast<int32_t>(point.x);
+            int32_t y = symmetry.sy * static_cast<int32_t>(point.y);
+            if (symmetry.transpose)
+                std::swap(x, y);
+            transformed[i] = {y, x};
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+        }
+        for (auto& [y, x] : transformed)
+        {
+            y -= minY;
+            x -= minX;
+        }
+
+        // row major order of the transformed cells
+        for (uint32_t i = 0; i < numCells; i++)
+            order[i] = i;
+        std::sort(order.begin(), order.end(),
+            [&](uint32_t a, uint32_t b)
+            {
+                return transformed[a] < transformed[b];
+            });
+        for (uint32_t i = 0; i < numCells; i++)
+            ranks[order[i]] = i;
+
+        key.assign(1, numCells);
+        for (uint32_t idx : order)
+        {
+            key.push_back(transformed[idx].second);
+            key.push_back(transformed[idx].first);
+        }
+
+        for (uint32_t c = 0; c < component.constraints.size(); c++)
+        {
+            const auto& constraint = component.constraints[c];
+            auto& encoded = encodedConstraints[c];
+            encoded.clear();
+            encoded.push_back(constraint.indices.size());
+            for (uint32_t idx : constraint.indices)
+                encoded.push_back(ranks[idx]);
+            std::sort(encoded.begin() + 1, encoded.end());
+            encoded.push_back(constraint.sum);
+        }
+        sortedConstraints.clear();
+        for (const auto& encoded : encodedConstraints)
+            sortedConstraints.push_back(&encoded);
+        std::sort(sortedConstraints.begin(), sortedConstraints.end(),
+            [](const auto* a, const auto* b)
+            {
+                return *a < *b;
+            });
+        for (const auto* encoded : sortedConstraints)
+            key.insert(key.end(), encoded->begin(), encoded->end());
+
+        if (best.key.empty() || key < best.key)
+        {
+            best.key = key;
+            best.order = order;
+        }
+    }
+    return best;
+}
+
+// Histograms of recently solved components, keyed by their canonical form
+// Lookups and insertions move an entry to the front, and the least recently used entry
+// is evicted once there are more than capacity entries
+// Not thread safe, use one cache per thread
+class ComponentCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    ComponentCache(size_t capacity = DEFAULT_CAPACITY);
+
+    // the histogram of component, if a component with the same canonical form was inserted
+    // the histogram is allocated from resource
+    std::optional<mine_counts::Histogram> find(const components::Component& component,
+        const CanonicalForm& form,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    // histogram has to be the histogram of component
+    void insert(const CanonicalForm& form, const mine_counts::Histogram& histogram);
+
+    uint64_t lookups() const;
+    uint64_t hits() const;
+    double hitRate() const;
+    size_t size() const;
+
+private:
+    // keys can be looked up by any contiguous range, so lookups don't copy the key
+    struct KeyHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::span<const uint32_t> key) const noexcept
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            for (uint32_t value : key)
+            {
+                hash ^= value;
+                hash *= 0x100000001b3;
+            }
+            return hash;
+        }
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(std::span<const uint32_t> a, std::span<const uint32_t> b) const noexcept
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        }
+    };
+
+    struct Entry
+    {
+        // in canonical cell order
+        std::vector<uint64_t> configurations;
+        std::vector<uint64_t> hits;
+        std::list<const std::vector<uint32_t>*>::iterator lruPosition;
+    };
+
+    size_t m_Capacity;
+    std::unordered_map<std::vector<uint32_t>, Entry, KeyHash, KeyEqual> m_Entries;
+    // keys of m_Entries, most recently used first
+    std::list<const std::vector<uint32_t>*> m_Lru;
+
+    uint64_t m_Lookups = 0;
+    uint64_t m_Hits = 0;
+};
+
+inline ComponentCache::ComponentCache(size_t capacity)
+    : m_Capacity(capacity)
+{
+}
+
+inline std::optional<mine_counts::Histogram> ComponentCache::find(
+    const components::Component& component, const CanonicalForm& form,
+    std::pmr::memory_resource* resource)
+{
+    m_Lookups++;
+    auto it = m_Entries.find(form.key);
+    if (it == m_Entries.end())
+        return {};
+    m_Hits++;
+
+    Entry& entry = it->second;
+    m_Lru.splice(m_Lru.begin(), m_Lru, entry.lruPosition);
+
+    const uint32_t numCells = component.cells.size();
+    mine_counts::Histogram histogram(component.cells, resource);
+    histogram.configurations.assign(entry.configurations.begin(), entry.configurations.end());
+    for (uint32_t k = 0; k <= numCells; k++)
+    {
+        for (uint32_t i = 0; i < numCells; i++)
+            histogram.hits[k * numCells + form.order[i]] = entry.hits[k * numCells + i];
+    }
+    return histogram;
+}
+
+inline void ComponentCache::insert(
+    const CanonicalForm& form, const mine_counts::Histogram& histogram)
+{
+    if (m_Capacity == 0)
+        return;
+
+    auto [it, inserted] =
+        m_Entries.try_emplace(std::vector<uint32_t>(form.key.begin(), form.key.end()));
+    Entry& entry = it->second;
+    if (inserted)
+    {
+        m_Lru.push_front(&it->first);
+        entry.lruPosition = m_Lru.begin();
+    }
+    else
+        m_Lru.splice(m_Lru.begin(), m_Lru, entry.lruPosition);
+
+    const uint32_t numCells = histogram.cells.size();
+    entry.configurations.assign(histogram.configurations.begin(), histogram.configurations.end());
+    entry.hits.resize(histogram.hits.size());
+    for (uint32_t k = 0; k <= numCells; k++)
+    {
+        for (uint32_t i = 0; i < numCells; i++)
+            entry.hits[k * numCells + i] = histogram.hits[k * numCells + form.order[i]];
+    }
+
+    if (m_Entries.size() > m_Capacity)
+    {
+        m_Entries.erase(m_Entries.find(*m_Lru.back()));
+        m_Lru.pop_back();
+    }
+}
+
+inline uint64_t ComponentCache::lookups() const
+{
+    return m_Lookups;
+}
+
+inline uint64_t ComponentCache::hits() const
+{
+    return m_Hits;
+}
+
+inline double ComponentCache::hitRate() const
+{
+    return m_Lookups == 0 ? 0.0 : static_cast<double>(m_Hits) / static_cast<double>(m_Lookups);
+}
+
+inline size_t ComponentCache::size() const
+{
+    return m_Entries.size();
+}
+
+}
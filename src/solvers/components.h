@@ -0,0 +1,260 @@
+#pragma once
+
+#include "../board_image.h"
+#include "../types.h"
+#include "../util/grid_index.h"
+#include "../util/static_vector.h"
+
+#include <algorithm>
+#include <memory_resource>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace solvers::components
+{
+
+// a numbered cell in terms of frontier indices
+// unlike brute_force::Constraint this is not limited to 64 cells
+struct FrontierConstraint
+{
+    StaticVector<uint32_t, 8> indices;
+    uint32_t sum;
+};
+
+// a group of frontier cells that share constraints with each other
+// but not with any cell outside of the group
+struct Component
+{
+    // frontier indices, in increasing order unless the component was renumbered
+    // position in this list is the index of the cell within the component
+    std::pmr::vector<uint32_t> cells;
+    // constraint indices are in terms of component indices
+    std::pmr::vector<FrontierConstraint> constraints;
+
+    Component(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : cells(resource), constraints(resource)
+    {
+    }
+};
+
+// the uncleared cells next to numbered cells, and the numbered cells as constraints on them
+struct Frontier
+{
+    // each cell is assigned an index into cells, in the order the numbered cells reach it
+    std::pmr::vector<Point> cells;
+    std::pmr::vector<FrontierConstraint> constraints;
+    // uncleared cells that aren't next to any numbered cell
+    uint32_t outsideCells = 0;
+
+    Frontier(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : cells(resource), constraints(resource)
+    {
+    }
+};
+
+// fills frontier from the numbered cells of image, frontier has to be empty
+// cellIndices is reset to the size of the board first, and maps each cell to its index
+inline void buildFrontier(const BoardImage& image, GridIndex& cellIndices, Frontier& frontier)
+{
+    cellIndices.reset(image.width(), image.height());
+    for (const auto& cell : image.numberedCells())
+    {
+        FrontierConstraint constraint = {};
+        for (auto neighbor : cell.unclearedNeighbors)
+        {
+            auto [idx, inserted] = cellIndices.insert(neighbor, frontier.cells.size());
+            if (inserted)
+                frontier.cells.push_back(neighbor);
+            constraint.indices.push_back(idx);
+        }
+        constraint.sum = cell.adjacentMines;
+        frontier.constraints.push_back(constraint);
+    }
+
+    frontier.outsideCells = image.width() * image.height() - frontier.cells.size()
+        - image.zeroCells().size() - image.numberedCells().size();
+}
+
+inline Frontier buildFrontier(
+    const BoardImage& image, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    GridIndex cellIndices;
+    Frontier frontier(resource);
+    buildFrontier(image, cellIndices, frontier);
+    return frontier;
+}
+
+inline uint32_t findRoot(std::span<uint32_t> parents, uint32_t idx)
+{
+    while (parents[idx] != idx)
+    {
+        parents[idx] = parents[parents[idx]];
+        idx = parents[idx];
+    }
+    return idx;
+}
+
+// union-find the frontier cells over the constraints they share
+// components are ordered by their lowest frontier index
+inline std::pmr::vector<Component> split(uint32_t numCells,
+    std::span<const FrontierConstraint> constraints,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    std::pmr::vector<uint32_t> parents(numCells, resource);
+    std::iota(parents.begin(), parents.end(), 0);
+
+    for (const auto& constraint : constraints)
+    {
+        if (constraint.indices.size() == 0)
+            continue;
+        uint32_t root = findRoot(parents, constraint.indices[0]);
+        for (uint32_t idx : constraint.indices)
+        {
+            uint32_t other = findRoot(parents, idx);
+            // keep the lowest index as the root so components come out in index order
+            if (other < root)
+                std::swap(other, root);
+            parents[other] = root;
+        }
+    }
+
+    std::pmr::vector<Component> result(resource);
+    // which component each frontier index is in, and its index within that component
+    std::pmr::vector<uint32_t> componentIndices(numCells, resource);
+    std::pmr::vector<uint32_t> localIndices(numCells, resource);
+    for (uint32_t i = 0; i < numCells; i++)
+    {
+        uint32_t root = findRoot(parents, i);
+        if (root == i)
+        {
+            componentIndices[i] = result.size();
+            result.emplace_back(resource);
+        }
+        else
+            componentIndices[i] = componentIndices[root];
+
+        Component& component = result[componentIndices[i]];
+        localIndices[i] = component.cells.size();
+        component.cells.push_back(i);
+    }
+
+    for (const auto& constraint : constraints)
+    {
+        if (constraint.indices.size() == 0)
+        {
+            // a constraint with no unknown cells is either trivially satisfied
+            // or can never be satisfied, which is represented by an empty component
+            // with no valid configurations
+            if (constraint.sum != 0)
+            {
+                Component& empty = result.emplace_back(resource);
+                empty.constraints.push_back(constraint);
+            }
+            continue;
+        }
+
+        FrontierConstraint local = {};
+        local.sum = constraint.sum;
+        for (uint32_t idx : constraint.indices)
+            local.indices.push_back(localIndices[idx]);
+        result[componentIndices[constraint.indices[0]]].constraints.push_back(local);
+    }
+
+    return result;
+}
+
+// Cuthill-McKee ordering of the cells of a component over the graph of cells sharing a constraint
+// breadth first search from a cell with the fewest neighbors, visiting neighbors with fewer
+// neighbors first, which keeps the cells of every constraint close together
+// returns order, where order[i] is the current index of the cell that should get index i
+inline std::pmr::vector<uint32_t> cuthillMcKee(const Component& component,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    const uint32_t numCells = component.cells.size();
+    std::pmr::vector<std::pmr::vector<uint32_t>> neighbors(numCells, resource);
+    for (const auto& constraint : component.constraints)
+    {
+        for (uint32_t a : constraint.indices)
+        {
+            for (uint32_t b : constraint.indices)
+            {
+                if (a != b)
+                    neighbors[a].push_back(b);
+            }
+        }
+    }
+    for (auto& cellNeighbors : neighbors)
+    {
+        std::sort(cellNeighbors.begin(), cellNeighbors.end());
+        cellNeighbors.erase(
+            std::unique(cellNeighbors.begin(), cellNeighbors.end()), cellNeighbors.end());
+    }
+
+    const auto fewerNeighbors = [&](uint32_t a, uint32_t b)
+    {
+        return neighbors[a].size() < neighbors[b].size();
+    };
+
+    // cells are appended in the order they are queued, so order doubles as the queue
+    std::pmr::vector<uint32_t> order(resource);
+    std::pmr::vector<bool> visited(numCells, false, resource);
+    std::pmr::vector<uint32_t> next(resource);
+    // a component is connected, but loop anyway so every cell is ordered
+    for (uint32_t head = 0; order.size() < numCells;)
+    {
+        uint32_t start = UINT32_MAX;
+        for (uint32_t i = 0; i < numCells; i++)
+        {
+            if (!visited[i] && (start == UINT32_MAX || fewerNeighbors(i, start)))
+                start = i;
+        }
+
+        order.push_back(start);
+        visited[start] = true;
+        for (; head < order.size(); head++)
+        {
+            next.clear();
+            for (uint32_t neighbor : neighbors[order[head]])
+            {
+                if (!visited[neighbor])
+                {
+                    visited[neighbor] = true;
+                    next.push_back(neighbor);
+                }
+            }
+            // neighbors are in increasing order, breaking ties by index keeps the sort stable
+            // without the temporary buffer std::stable_sort allocates
+            std::sort(next.begin(), next.end(),
+                [&](uint32_t a, uint32_t b)
+                {
+                    return fewerNeighbors(a, b)
+                        || (neighbors[a].size() == neighbors[b].size() && a < b);
+                });
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    return order;
+}
+
+// moves the cell at index order[i] to index i
+inline void renumber(Component& component, std::span<const uint32_t> order)
+{
+    std::pmr::memory_resource* resource = component.cells.get_allocator().resource();
+    std::pmr::vector<uint32_t> newIndices(order.size(), resource);
+    std::pmr::vector<uint32_t> cells(order.size(), resource);
+    for (uint32_t i = 0; i < order.size(); i++)
+    {
+        newIndices[order[i]] = i;
+        cells[i] = component.cells[order[i]];
+    }
+
+    component.cells = std::move(cells);
+    for (auto& constraint : component.constraints)
+    {
+        for (uint32_t& idx : constraint.indices)
+            idx = newIndices[idx];
+    }
+}
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../util/aligned_allocator.h"
+#include "components.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace solvers::constraint_kernels
+{
+
+enum class Kernel
+{
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+// The vector kernels are only compiled in when the instruction set allows it, see CMakePresets.json
+// Because the constraints are sorted, the scalar kernel usually stops at the first constraint
+// and beats both vector kernels on the test suites (benchmarkConstraintKernels in main.cpp)
+constexpr Kernel DEFAULT_KERNEL = Kernel::SCALAR;
+
+// the constraints of a component in struct of arrays layout
+// sorted by decreasing lowest index bit, so the first unsatisfied constraint is the one
+// with the highest lowest index bit, and the kernels can stop as soon as they find one
+// padded with constraints that are always satisfied (empty mask, sum of 0)
+// up to a multiple of LANES so the vector kernels don't need a remainder loop
+struct ConstraintBlock
+{
+    static constexpr size_t LANES = 8;
+
+    template<typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T, 64>>;
+
+    AlignedVector<uint64_t> masks;
+    AlignedVector<uint64_t> sums;
+    // lowest index bit of each mask
+    AlignedVector<uint64_t> lowestBits;
+
+    ConstraintBlock(std::span<const components::FrontierConstraint> constraints,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : masks(resource), sums(resource), lowestBits(resource)
+    {
+        std::pmr::vector<uint64_t> constraintMasks(resource);
+        // decreasing lowest index bit in the high half, position in the low half, so sorting
+        // is stable without the temporary buffer std::stable_sort allocates
+        std::pmr::vector<uint64_t> keys(resource);
+        for (const auto& constraint : constraints)
+        {
+            uint64_t mask = 0;
+            for (uint32_t idx : constraint.indices)
+                mask |= 1ull << idx;
+            keys.push_back(static_cast<uint64_t>(64 - std::countr_zero(mask)) << 32
+                | constraintMasks.size());
+            constraintMasks.push_back(mask);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        for (uint64_t key : keys)
+        {
+            const uint32_t c = static_cast<uint32_t>(key);
+            const uint64_t mask = constraintMasks[c];
+            masks.push_back(mask);
+            sums.push_back(constraints[c].sum);
+            lowestBits.push_back(mask == 0 ? 0 : std::countr_zero(mask));
+        }
+
+        while (masks.size() % LANES != 0)
+        {
+            masks.push_back(0);
+            sums.push_back(0);
+            lowestBits.push_back(0);
+        }
+    }
+};
+
+// Checks every constraint against a configuration
+// returns -1 if all of them are satisfied, otherwise the highest lowest index bit
+// of the unsatisfied constraints, all configurations that don't change that bit can be skipped
+template<Kernel kernel>
+int jumpBit(const ConstraintBlock& block, uint64_t mines);
+
+template<>
+inline int jumpBit<Kernel::SCALAR>(const ConstraintBlock& block, uint64_t mines)
+{
+    for (size_t i = 0; i < block.masks.size(); i++)
+    {
+        if (static_cast<uint64_t>(std::popcount(block.masks[i] & mines)) != block.sums[i])
+            return static_cast<int>(block.lowestBits[i]);
+    }
+    return -1;
+}
+
+#if defined(__AVX2__)
+template<>
+inline int jumpBit<Kernel::AVX2>(const ConstraintBlock& block, uint64_t mines)
+{
+    const __m256i vmines = _mm256_set1_epi64x(static_cast<int64_t>(mines));
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+    // popcount of each nibble
+    const __m256i popcountLut = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+
+    for (size_t i = 0; i < block.masks.size(); i += 4)
+    {
+        __m256i masked = _mm256_and_si256(
+            _mm256_load_si256(reinterpret_cast<const __m256i*>(&block.masks[i])), vmines);
+
+        // no 64 bit popcount in AVX2, count nibbles with a lookup table and sum the bytes
+        __m256i low = _mm256_shuffle_epi8(popcountLut, _mm256_and_si256(masked, lowNibbles));
+        __m256i high = _mm256_shuffle_epi8(
+            popcountLut, _mm256_and_si256(_mm256_srli_epi16(masked, 4), lowNibbles));
+        __m256i counts = _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+
+        __m256i satisfied = _mm256_cmpeq_epi64(
+            counts, _mm256_load_si256(reinterpret_cast<const __m256i*>(&block.sums[i])));
+        int unsatisfied = ~_mm256_movemask_pd(_mm256_castsi256_pd(satisfied)) & 0xf;
+        if (unsatisfied != 0)
+            return static_cast<int>(block.lowestBits[i + std::countr_zero(
+                static_cast<uint32_t>(unsatisfied))]);
+    }
+    return -1;
+}
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+template<>
+inline int jumpBit<Kernel::AVX512>(const ConstraintBlock& block, uint64_t mines)
+{
+    const __m512i vmines = _mm512_set1_epi64(static_cast<int64_t>(mines));
+
+    for (size_t i = 0; i < block.masks.size(); i += 8)
+    {
+        __m512i counts =
+            _mm512_popcnt_epi64(_mm512_and_si512(_mm512_load_si512(&block.masks[i]), vmines));
+        __mmask8 unsatisfied = _mm512_cmpneq_epi64_mask(counts, _mm512_load_si512(&block.sums[i]));
+        if (unsatisfied != 0)
+            return static_cast<int>(block.lowestBits[i + std::countr_zero(
+                static_cast<uint32_t>(unsatisfied))]);
+    }
+    return -1;
+}
+#endif
+
+}
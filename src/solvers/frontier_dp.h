@@ -0,0 +1,403 @@
+#pragma once
+
+#include "../board_image.h"
+#include "basic_optimized.h"
+#include "components.h"
+#include "mine_counts.h"
+#include "solution_info.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace solvers::frontier_dp
+{
+
+// each open constraint takes 4 bits of the 64 bit state
+// components with more constraints open at once than this can't be swept
+constexpr uint32_t MAX_OPEN_CONSTRAINTS = 16;
+
+// Sweeps over the cells of a component in path order, one cell at a time
+// A constraint is open between its first and last cell, and the state after each cell
+// is the number of mines placed so far in every open constraint
+// Each state keeps the number of ways to reach it by mine count, so the work is only exponential
+// in the number of constraints open at the same time, not in the number of cells
+// A second sweep from the back gives the number of ways to finish from each state,
+// and the two combined give the hits of every cell
+// With n cells and at most S states per layer, the count vectors have up to n + 1 entries, so
+// the forward sweep takes O(n^2 S), and combining every start count with every finish count
+// for the hits takes O(n^3 S)
+class ComponentSweep
+{
+public:
+    // the cells of the component should be in path order, e.g. after components::renumber
+    ComponentSweep(const components::Component& component);
+
+    // empty if too many constraints are open at once or the counts don't fit in 64 bits
+    std::optional<mine_counts::Histogram> run();
+    // draws a valid configuration with probability proportional to mineWeight^(number of mines)
+    // mines[i] is set to whether cell i is a mine
+    // false if there is no valid configuration or too many constraints are open at once
+    bool sample(double mineWeight, std::mt19937_64& rng, std::vector<uint8_t>& mines);
+
+private:
+    // how a slot of the next state is computed from the current state
+    struct SlotTransition
+    {
+        // slot in the current state, -1 if the constraint starts at this cell
+        int32_t source;
+        bool containsCell;
+        uint32_t sum;
+        // cells of the constraint after this cell
+        uint32_t remaining;
+    };
+
+    // a constraint whose last cell is this cell, it has to be satisfied exactly
+    struct Closing
+    {
+        int32_t source;
+        uint32_t sum;
+    };
+
+    struct Layer
+    {
+        std::vector<uint64_t> states;
+        std::unordered_map<uint64_t, uint32_t> indices;
+        // counts[s][k] = number of ways to reach states[s] with k mines
+        std::vector<std::vector<uint64_t>> counts;
+
+        uint32_t insert(uint64_t state, size_t numMineCounts);
+    };
+
+    static uint32_t field(uint64_t state, int32_t slot);
+    bool transition(uint32_t cell, uint64_t state, bool mine, uint64_t& next) const;
+    void add(uint64_t& dst, uint64_t value);
+    void addProduct(uint64_t& dst, uint64_t a, uint64_t b);
+
+    const components::Component& m_Component;
+    bool m_Overflow = false;
+
+    // m_Transitions[i] builds the state after cell i
+    std::vector<std::vector<SlotTransition>> m_Transitions;
+    std::vector<std::vector<Closing>> m_Closings;
+};
+
+inline uint32_t ComponentSweep::Layer::insert(uint64_t state, size_t numMineCounts)
+{
+    auto [it, inserted] = indices.insert({state, static_cast<uint32_t>(states.size())});
+    if (inserted)
+    {
+        states.push_back(state);
+        counts.emplace_back(numMineCounts);
+    }
+    return it->second;
+}
+
+inline ComponentSweep::ComponentSweep(const components::Component& component)
+    : m_Component(component)
+{
+    const uint32_t numCells = component.cells.size();
+    // a component without cells only has constraints without cells, run() and sample()
+    // check those directly
+    if (numCells == 0)
+        return;
+
+    std::vector<uint32_t> firstCells;
+    std::vector<uint32_t> lastCells;
+    for (const auto& constraint : component.constraints)
+    {
+        auto [first, last] =
+            std::minmax_element(constraint.indices.begin(), constraint.indices.end());
+        firstCells.push_back(*first);
+        lastCells.push_back(*last);
+    }
+
+    // constraints open after each cell, in increasing constraint order
+    std::vector<std::vector<uint32_t>> open(numCells + 1);
+    for (uint32_t c = 0; c < component.constraints.size(); c++)
+    {
+        for (uint32_t i = firstCells[c] + 1; i <= lastCells[c]; i++)
+            open[i].push_back(c);
+    }
+
+    const auto slotOf = [&](uint32_t boundary, uint32_t c)
+    {
+        auto it = std::find(open[boundary].begin(), open[boundary].end(), c);
+        return it == open[boundary].end() ? -1 : static_cast<int32_t>(it - open[boundary].begin());
+    };
+
+    m_Transitions.resize(numCells);
+    m_Closings.resize(numCells);
+    for (uint32_t i = 0; i < numCells; i++)
+    {
+        for (uint32_t c : open[i + 1])
+        {
+            const auto& indices = component.constraints[c].indices;
+            SlotTransition slot = {};
+            slot.source = slotOf(i, c);
+            slot.containsCell = std::find(indices.begin(), indices.end(), i) != indices.end();
+            slot.sum = component.constraints[c].sum;
+            slot.remaining = std::count_if(
+                indices.begin(), indices.end(), [i](uint32_t idx) { return idx > i; });
+            m_Transitions[i].push_back(slot);
+        }
+    }
+    for (uint32_t c = 0; c < component.constraints.size(); c++)
+        m_Closings[lastCells[c]].push_back({slotOf(lastCells[c], c), component.constraints[c].sum});
+
+    for (const auto& boundary : open)
+    {
+        if (boundary.size() > MAX_OPEN_CONSTRAINTS)
+            m_Overflow = true;
+    }
+}
+
+inline uint32_t ComponentSweep::field(uint64_t state, int32_t slot)
+{
+    return slot < 0 ? 0 : (state >> (4 * slot)) & 0xf;
+}
+
+inline bool ComponentSweep::transition(
+    uint32_t cell, uint64_t state, bool mine, uint64_t& next) const
+{
+    for (const Closing& closing : m_Closings[cell])
+    {
+        if (field(state, closing.source) + mine != closing.sum)
+            return false;
+    }
+
+    next = 0;
+    const auto& slots = m_Transitions[cell];
+    for (uint32_t j = 0; j < slots.size(); j++)
+    {
+        const SlotTransition& slot = slots[j];
+        uint32_t partial = field(state, slot.source) + (slot.containsCell && mine);
+        // too many mines already, or not enough cells left to reach the sum
+        if (partial > slot.sum || partial + slot.remaining < slot.sum)
+            return false;
+        next |= static_cast<uint64_t>(partial) << (4 * j);
+    }
+    return true;
+}
+
+inline void ComponentSweep::add(uint64_t& dst, uint64_t value)
+{
+    m_Overflow |= value > UINT64_MAX - dst;
+    dst += value;
+}
+
+inline void ComponentSweep::addProduct(uint64_t& dst, uint64_t a, uint64_t b)
+{
+    m_Overflow |= b != 0 && a > UINT64_MAX / b;
+    add(dst, a * b);
+}
+
+inline std::optional<mine_counts::Histogram> ComponentSweep::run()
+{
+    const uint32_t numCells = m_Component.cells.size();
+    mine_counts::Histogram histogram(m_Component.cells);
+
+    if (numCells == 0)
+    {
+        // only constraints without any unknown cells, which all have to be already satisfied
+        bool valid = true;
+        for (const auto& constraint : m_Component.constraints)
+            valid &= constraint.sum == 0;
+        histogram.configurations[0] = valid;
+        return histogram;
+    }
+    if (m_Overflow)
+        return {};
+
+    // forward sweep, layers[i] is the state before cell i
+    std::vector<Layer> layers(numCells + 1);
+    layers[0].insert(0, 1);
+    layers[0].counts[0][0] = 1;
+    for (uint32_t i = 0; i < numCells; i++)
+    {
+        const Layer& curr = layers[i];
+        Layer& next = layers[i + 1];
+        for (uint32_t s = 0; s < curr.states.size(); s++)
+        {
+            for (bool mine : {false, true})
+            {
+                uint64_t nextState;
+                if (!transition(i, curr.states[s], mine, nextState))
+                    continue;
+                uint32_t t = next.insert(nextState, i + 2);
+                for (uint32_t k = 0; k <= i; k++)
+                    add(next.counts[t][k + mine], curr.counts[s][k]);
+            }
+        }
+    }
+
+    // every constraint is closed after the last cell, so there is at most one state left
+    if (layers[numCells].states.empty())
+        return histogram;
+    histogram.configurations.assign(
+        layers[numCells].counts[0].begin(), layers[numCells].counts[0].end());
+
+    // backward sweep, ways[s][k] = number of ways to finish from states[s] of the
+    // current layer with k more mines
+    std::vector<std::vector<uint64_t>> nextWays = {{1}};
+    for (uint32_t i = numCells; i-- > 0;)
+    {
+        const Layer& curr = layers[i];
+        const Layer& next = layers[i + 1];
+        std::vector<std::vector<uint64_t>> ways(
+            curr.states.size(), std::vector<uint64_t>(numCells - i + 1));
+        for (uint32_t s = 0; s < curr.states.size(); s++)
+        {
+            for (bool mine : {false, true})
+            {
+                uint64_t nextState;
+                if (!transition(i, curr.states[s], mine, nextState))
+                    continue;
+                // states that can't be finished are still in the forward layers,
+                // they just have no ways to finish
+                const std::vector<uint64_t>& finish = nextWays[next.indices.at(nextState)];
+                for (uint32_t k = 0; k < finish.size(); k++)
+                    add(ways[s][k + mine], finish[k]);
+
+                if (!mine)
+                    continue;
+                const std::vector<uint64_t>& start = curr.counts[s];
+                for (uint32_t a = 0; a < start.size(); a++)
+                {
+                    if (start[a] == 0)
+                        continue;
+                    for (uint32_t b = 0; b < finish.size(); b++)
+                        addProduct(histogram.hits[(a + b + 1) * numCells + i], start[a], finish[b]);
+                }
+            }
+        }
+        nextWays = std::move(ways);
+    }
+
+    if (m_Overflow)
+        return {};
+    return histogram;
+}
+
+inline bool ComponentSweep::sample(
+    double mineWeight, std::mt19937_64& rng, std::vector<uint8_t>& mines)
+{
+    const uint32_t numCells = m_Component.cells.size();
+    mines.assign(numCells, 0);
+    if (numCells == 0)
+    {
+        bool valid = true;
+        for (const auto& constraint : m_Component.constraints)
+            valid &= constraint.sum == 0;
+        return valid;
+    }
+    if (m_Overflow)
+        return false;
+
+    // forward sweep with the total weight of the ways to reach each state instead of counts,
+    // normalized after every cell so they stay in range of a double
+    std::vector<std::vector<uint64_t>> states(numCells + 1);
+    std::vector<std::vector<double>> weights(numCells + 1);
+    states[0] = {0};
+    weights[0] = {1.0};
+    for (uint32_t i = 0; i < numCells; i++)
+    {
+        std::unordered_map<uint64_t, uint32_t> indices;
+        double largest = 0.0;
+        for (uint32_t s = 0; s < states[i].size(); s++)
+        {
+            for (bool mine : {false, true})
+            {
+                uint64_t nextState;
+                if (!transition(i, states[i][s], mine, nextState))
+                    continue;
+                auto [it, inserted] = indices.insert({nextState, states[i + 1].size()});
+                if (inserted)
+                {
+                    states[i + 1].push_back(nextState);
+                    weights[i + 1].push_back(0.0);
+                }
+                double& weight = weights[i + 1][it->second];
+                weight += weights[i][s] * (mine ? mineWeight : 1.0);
+                largest = std::max(largest, weight);
+            }
+        }
+        if (largest == 0.0)
+            return false;
+        for (double& weight : weights[i + 1])
+            weight /= largest;
+    }
+
+    // walk back from the single final state, picking each predecessor in proportion
+    // to the weight of the ways to reach it
+    uint64_t state = states[numCells][0];
+    for (uint32_t i = numCells; i-- > 0;)
+    {
+        double total = 0.0;
+        for (uint32_t s = 0; s < states[i].size(); s++)
+        {
+            for (bool mine : {false, true})
+            {
+                uint64_t nextState;
+                if (transition(i, states[i][s], mine, nextState) && nextState == state)
+                    total += weights[i][s] * (mine ? mineWeight : 1.0);
+            }
+        }
+
+        double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+        uint64_t prevState = 0;
+        bool prevMine = false;
+        for (uint32_t s = 0; s < states[i].size() && target >= 0.0; s++)
+        {
+            for (bool mine : {false, true})
+            {
+                uint64_t nextState;
+                if (!transition(i, states[i][s], mine, nextState) || nextState != state)
+                    continue;
+                prevState = states[i][s];
+                prevMine = mine;
+                target -= weights[i][s] * (mine ? mineWeight : 1.0);
+                if (target < 0.0)
+                    break;
+            }
+        }
+        mines[i] = prevMine;
+        state = prevState;
+    }
+    return true;
+}
+
+// empty if a component left after reduction can't be swept
+inline std::optional<SolutionInfo> solve(const BoardImage& image)
+{
+    const components::Frontier frontier = components::buildFrontier(image);
+    // the reducer takes out everything it can deduce, which splits long components
+    // into shorter ones that have fewer constraints open at once
+    basic_optimized::ReducedFrontier reduced =
+        basic_optimized::reduceFrontier(frontier.cells, frontier.constraints);
+    const basic_optimized::FrontierSolution& result = reduced.solution;
+
+    std::vector<mine_counts::Histogram> histograms;
+    for (auto& component : reduced.components)
+    {
+        // a low bandwidth order keeps few constraints open at once
+        components::renumber(component, components::cuthillMcKee(component));
+        std::optional<mine_counts::Histogram> histogram = ComponentSweep(component).run();
+        if (!histogram)
+            return {};
+        histograms.push_back(std::move(histogram.value()));
+    }
+
+    const uint32_t availableMines = image.numMines() - result.knownMines.size();
+    SolutionInfo solution = mine_counts::combine(
+        result.uncleared, histograms, frontier.outsideCells, availableMines);
+    solution.mines.insert(solution.mines.end(), result.knownMines.begin(), result.knownMines.end());
+    solution.clears.insert(
+        solution.clears.end(), result.knownClears.begin(), result.knownClears.end());
+    return {solution};
+}
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "../util/parallel.h"
+#include "components.h"
+#include "constraint_kernels.h"
+#include "mine_counts.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace solvers::meet_in_the_middle
+{
+
+// smaller components are faster to enumerate directly
+constexpr uint32_t MIN_CELLS = 16;
+// each half has to fit in a 64 bit configuration
+constexpr uint32_t MAX_CELLS = 80;
+// the partial sums of the constraints crossing the split take 4 bits each of the signature
+constexpr uint32_t MAX_CROSSING = 16;
+
+// a constraint with cells on both sides of the split
+struct CrossingConstraint
+{
+    // cells in each half, as bits of that half's configuration
+    uint64_t lowMask;
+    uint64_t highMask;
+    uint32_t sum;
+};
+
+// valid configurations of one half, grouped by the mines they put in the crossing constraints
+// the low half is keyed by the partial sums it has, and the high half by the partial sums it
+// needs from the low half, so matching configurations have equal keys
+using HalfTable = std::pmr::unordered_map<uint64_t, mine_counts::Histogram>;
+
+// enumerates the configurations of a half that satisfy the constraints inside of it
+template<constraint_kernels::Kernel kernel>
+HalfTable enumerateHalf(uint32_t numCells,
+    std::span<const components::FrontierConstraint> constraints,
+    std::span<const CrossingConstraint> crossing, bool high, uint64_t& visited,
+    std::pmr::memory_resource* resource)
+{
+    const constraint_kernels::ConstraintBlock block(constraints, resource);
+    std::pmr::vector<uint32_t> cells(numCells, resource);
+    std::iota(cells.begin(), cells.end(), 0);
+
+    HalfTable table(resource);
+    const uint64_t end = 1ull << numCells;
+    for (uint64_t mines = 0; mines < end;)
+    {
+        visited++;
+        int jumpBit = constraint_kernels::jumpBit<kernel>(block, mines);
+        if (jumpBit >= 0)
+        {
+            mines &= ~((1ull << jumpBit) - 1);
+            mines += 1ull << jumpBit;
+            continue;
+        }
+
+        uint64_t key = 0;
+        bool possible = true;
+        for (uint32_t j = 0; j < crossing.size(); j++)
+        {
+            const uint64_t ownMask = high ? crossing[j].highMask : crossing[j].lowMask;
+            const uint64_t otherMask = high ? crossing[j].lowMask : crossing[j].highMask;
+            const uint32_t partial = std::popcount(mines & ownMask);
+            // the other half has to be able to make up the rest of the sum
+            possible &= partial <= crossing[j].sum
+                && crossing[j].sum - partial <= static_cast<uint32_t>(std::popcount(otherMask));
+            const uint32_t field = high ? crossing[j].sum - partial : partial;
+            key |= static_cast<uint64_t>(field & 0xf) << (4 * j);
+        }
+        if (possible)
+            table.try_emplace(key, cells, resource).first->second.addConfiguration(mines);
+
+        mines++;
+    }
+    return table;
+}
+
+// Splits the cells of a component into a low and a high half at the index with the fewest
+// constraints crossing it, enumerates each half on its own, and joins the halves whose
+// crossing constraint sums add up. That takes about 2^(n/2) work per half instead of 2^n
+// The cells should be in a low bandwidth order so only a few constraints cross the split
+// empty if too many constraints cross the split or the counts don't fit in 64 bits
+// with more than one thread the two halves are enumerated at the same time
+template<constraint_kernels::Kernel kernel>
+std::optional<mine_counts::Histogram> solve(const components::Component& component,
+    uint32_t numThreads = 1, uint64_t* visitedConfigurations = nullptr,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    const uint32_t numCells = component.cells.size();
+    if (numCells < 2 || numCells > MAX_CELLS)
+        return {};
+
+    std::pmr::vector<uint32_t> firstCells(resource);
+    std::pmr::vector<uint32_t> lastCells(resource);
+    for (const auto& constraint : component.constraints)
+    {
+        auto [first, last] =
+            std::minmax_element(constraint.indices.begin(), constraint.indices.end());
+        firstCells.push_back(constraint.indices.size() == 0 ? 0 : *first);
+        lastCells.push_back(constraint.indices.size() == 0 ? 0 : *last);
+    }
+
+    // split near the middle, both halves have to fit in 64 bits
+    const uint32_t lowest =
+        std::max({1u, numCells / 2 - numCells / 8, numCells - std::min(63u, numCells)});
+    const uint32_t highest = std::min({63u, numCells - 1, numCells / 2 + numCells / 8});
+    uint32_t split = numCells / 2;
+    uint32_t fewestCrossing = UINT32_MAX;
+    for (uint32_t candidate = lowest; candidate <= highest; candidate++)
+    {
+        uint32_t numCrossing = 0;
+        for (uint32_t c = 0; c < component.constraints.size(); c++)
+            numCrossing += firstCells[c] < candidate && lastCells[c] >= candidate;
+        if (numCrossing < fewestCrossing)
+        {
+            fewestCrossing = numCrossing;
+            split = candidate;
+        }
+    }
+    if (fewestCrossing > MAX_CROSSING)
+        return {};
+
+    std::pmr::vector<components::FrontierConstraint> lowConstraints(resource);
+    std::pmr::vector<components::FrontierConstraint> highConstraints(resource);
+    std::pmr::vector<CrossingConstraint> crossing(resource);
+    for (uint32_t c = 0; c < component.constraints.size(); c++)
+    {
+        const auto& constraint = component.constraints[c];
+        if (lastCells[c] < split)
+            lowConstraints.push_back(constraint);
+        else if (firstCells[c] >= split)
+        {
+            components::FrontierConstraint shifted = {};
+            shifted.sum = constraint.sum;
+            for (uint32_t idx : constraint.indices)
+                shifted.indices.push_back(idx - split);
+            highConstraints.push_back(shifted);
+        }
+        else
+        {
+            CrossingConstraint cross = {0, 0, constraint.sum};
+            for (uint32_t idx : constraint.indices)
+            {
+                if (idx < split)
+                    cross.lowMask |= 1ull << idx;
+                else
+                    cross.highMask |= 1ull << (idx - split);
+            }
+            crossing.push_back(cross);
+        }
+    }
+
+    const uint32_t numLow = split;
+    const uint32_t numHigh = numCells - split;
+    uint64_t lowVisited = 0;
+    uint64_t highVisited = 0;
+    // resource isn't synchronized, so the high half gets its own arena when it has its own thread
+    std::pmr::monotonic_buffer_resource highArena(std::pmr::new_delete_resource());
+    std::pmr::memory_resource* highResource = numThreads > 1 ? &highArena : resource;
+    HalfTable low(resource);
+    HalfTable high(highResource);
+    parallelFor(2, std::min(numThreads, 2u),
+        [&](uint32_t, uint64_t half)
+        {
+            if (half == 0)
+                low = enumerateHalf<kernel>(
+                    numLow, lowConstraints, crossing, false, lowVisited, resource);
+            else
+                high = enumerateHalf<kernel>(
+                    numHigh, highConstraints, crossing, true, highVisited, highResource);
+        });
+    if (visitedConfigurations)
+        *visitedConfigurations += lowVisited + highVisited;
+
+    bool overflow = false;
+    const auto addProduct = [&](uint64_t& dst, uint64_t a, uint64_t b)
+    {
+        overflow |= b != 0 && a > UINT64_MAX / b;
+        overflow |= a * b > UINT64_MAX - dst;
+        dst += a * b;
+    };
+
+    // every low configuration combines with every high configuration that has the same key
+    mine_counts::Histogram histogram(component.cells, resource);
+    for (const auto& [key, lowHistogram] : low)
+    {
+        auto it = high.find(key);
+        if (it == high.end())
+            continue;
+        const mine_counts::Histogram& highHistogram = it->second;
+
+        for (uint32_t a = 0; a <= numLow; a++)
+        {
+            const uint64_t lowCount = lowHistogram.configurations[a];
+            if (lowCount == 0)
+                continue;
+            for (uint32_t b = 0; b <= numHigh; b++)
+            {
+                const uint64_t highCount = highHistogram.configurations[b];
+                if (highCount == 0)
+                    continue;
+                const uint32_t k = a + b;
+                addProduct(histogram.configurations[k], lowCount, highCount);
+                uint64_t* hits = &histogram.hits[k * numCells];
+                for (uint32_t i = 0; i < numLow; i++)
+                    addProduct(hits[i], lowHistogram.hits[a * numLow + i], highCount);
+                for (uint32_t i = 0; i < numHigh; i++)
+                    addProduct(hits[split + i], lowCount, highHistogram.hits[b * numHigh + i]);
+            }
+        }
+    }
+
+    if (overflow)
+        return {};
+    return histogram;
+}
+
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "../types.h"
+#include "../util/big_uint.h"
+#include "../util/bitset.h"
+#include "../util/scaled_double.h"
+#include "solution_info.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace solvers::mine_counts
+{
+
+// valid configurations of a group of frontier cells, bucketed by the number of mines in them
+// counting is kept separate from weighting so the enumeration loops don't do any floating point
+struct Histogram
+{
+    // frontier indices of the cells, bit i of a configuration corresponds to cells[i]
+    std::pmr::vector<uint32_t> cells;
+    // configurations[k] = number of valid configurations with k mines
+    std::pmr::vector<uint64_t> configurations;
+    // hits[k * cells.size() + i] = number of those configurations where cell i is a mine
+    std::pmr::vector<uint64_t> hits;
+    // false if the counts are sampled estimates, only scaled to fit the integers
+    // they still give the ratios between counts, but never prove a cell is always a mine or clear
+    bool exact = true;
+
+    Histogram(std::span<const uint32_t> cells,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : cells(cells.begin(), cells.end(), resource),
+          configurations(cells.size() + 1, resource),
+          hits((cells.size() + 1) * cells.size(), resource)
+    {
+    }
+
+    void addConfiguration(uint64_t mines)
+    {
+        const uint32_t numMines = std::popcount(mines);
+        configurations[numMines]++;
+
+        uint64_t* cellHits = &hits[numMines * cells.size()];
+        while (mines > 0)
+            cellHits[poplsb(mines)]++;
+    }
+
+    // for groups that are too large to represent a configuration as a single mask
+    void addConfiguration(std::span<const uint32_t> mineCells)
+    {
+        configurations[mineCells.size()]++;
+
+        uint64_t* cellHits = &hits[mineCells.size() * cells.size()];
+        for (uint32_t cell : mineCells)
+            cellHits[cell]++;
+    }
+
+    // histograms of disjoint sets of configurations of the same cells
+    Histogram& operator+=(const Histogram& other)
+    {
+        for (size_t i = 0; i < configurations.size(); i++)
+            configurations[i] += other.configurations[i];
+        for (size_t i = 0; i < hits.size(); i++)
+            hits[i] += other.hits[i];
+        return *this;
+    }
+
+    uint64_t numConfigurations() const
+    {
+        uint64_t result = 0;
+        for (uint64_t count : configurations)
+            result += count;
+        return result;
+    }
+};
+
+inline std::pmr::vector<ScaledDouble> convolve(std::span<const ScaledDouble> a,
+    std::span<const ScaledDouble> b,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    std::pmr::vector<ScaledDouble> result(a.size() + b.size() - 1, resource);
+    for (size_t i = 0; i < a.size(); i++)
+        for (size_t j = 0; j < b.size(); j++)
+            result[i + j] += a[i] * b[j];
+    return result;
+}
+
+// weights[k] is the relative weight of a single frontier configuration with k mines
+// weight is proportional to N choose M, where N is
+// the number of other squares that mines can be in
+// and M is the number of mines that can be in those squares
+// The ratios between consecutive weights are multiplied together instead of computing each
+// binomial directly, and kept in a ScaledDouble so that huge outside regions don't underflow
+inline std::pmr::vector<ScaledDouble> configurationWeights(uint32_t maxMines,
+    uint32_t outsideMineCells, uint32_t availableMines,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    const int64_t outside = outsideMineCells;
+    const int64_t available = availableMines;
+
+    std::pmr::vector<ScaledDouble> weights(maxMines + 1, resource);
+    // with fewer than available - outside mines in the frontier,
+    // the rest of the mines don't fit outside of it
+    const int64_t minMines = std::max<int64_t>(0, available - outside);
+    ScaledDouble currWeight = 1.0;
+    for (int64_t i = minMines; i <= std::min<int64_t>(maxMines, available); i++)
+    {
+        weights[i] = currWeight;
+        // (N choose M - i - 1) / (N choose M - i)
+        currWeight *= static_cast<double>(available - i);
+        currWeight /= static_cast<double>(outside - available + i + 1);
+    }
+    return weights;
+}
+
+// Combine the histograms of independent groups of cells into the solution for the whole frontier
+// The mine count distribution of the frontier is the convolution of the distributions
+// of each group, and each total mine count is weighted by the number of ways the
+// remaining mines can be placed outside of the frontier
+// The result is written into solution, reusing the memory it already has, and the scratch
+// memory comes from resource
+inline void combine(std::span<const Point> uncleared, std::span<const Histogram> histograms,
+    uint32_t outsideMineCells, uint32_t availableMines, SolutionInfo& solution,
+    std::pmr::memory_resource* resource)
+{
+    solution.mines.clear();
+    solution.clears.clear();
+    solution.mineProbs.clear();
+    solution.outsideMineProb = 0.0;
+    solution.exact = true;
+    solution.probError = 0.0;
+    solution.initMineProbs(uncleared);
+
+    std::pmr::vector<std::pmr::vector<ScaledDouble>> distributions(resource);
+    for (const auto& histogram : histograms)
+    {
+        auto& distribution = distributions.emplace_back();
+        for (uint64_t count : histogram.configurations)
+            distribution.push_back(static_cast<double>(count));
+    }
+
+    // prefixes[i] = distribution of groups [0, i)
+    std::pmr::vector<std::pmr::vector<ScaledDouble>> prefixes(resource);
+    prefixes.emplace_back(1, 1.0);
+    for (const auto& distribution : distributions)
+        prefixes.push_back(convolve(prefixes.back(), distribution, resource));
+
+    const std::pmr::vector<ScaledDouble>& total = prefixes.back();
+
+    const std::pmr::vector<ScaledDouble> weights =
+        configurationWeights(total.size() - 1, outsideMineCells, availableMines, resource);
+
+    // tails[i][m] = weight of every configuration of groups [i, n), given m mines in groups
+    // [0, i), so each group only costs its size times the frontier size instead of a full
+    // convolution of all the other groups
+    std::pmr::vector<std::pmr::vector<ScaledDouble>> tails(distributions.size() + 1, resource);
+    tails.back() = weights;
+    for (size_t i = distributions.size(); i-- > 0;)
+    {
+        tails[i].resize(prefixes[i].size());
+        for (size_t m = 0; m < tails[i].size(); m++)
+            for (size_t k = 0; k < distributions[i].size(); k++)
+                tails[i][m] += distributions[i][k] * tails[i + 1][m + k];
+    }
+
+    ScaledDouble totalWeight = 0.0;
+    ScaledDouble outsideMines = 0.0;
+    for (uint32_t i = 0; i < total.size(); i++)
+    {
+        ScaledDouble weight = weights[i] * total[i];
+        totalWeight += weight;
+        // weight is 0 whenever there are more frontier mines than available mines
+        if (i < availableMines)
+            outsideMines += weight * static_cast<double>(availableMines - i);
+    }
+    // every outside cell is equally likely to be a mine
+    if (outsideMineCells > 0)
+        solution.outsideMineProb =
+            (outsideMines / totalWeight).toDouble() / static_cast<double>(outsideMineCells);
+
+    solution.numValidSolutions = 1;
+    bool anyUnsatisfiable = false;
+    for (const auto& histogram : histograms)
+    {
+        uint64_t groupSolutions = histogram.numConfigurations();
+        solution.numValidSolutions *= groupSolutions;
+        anyUnsatisfiable |= groupSolutions == 0;
+        solution.exact &= histogram.exact;
+    }
+    if (!solution.exact)
+        solution.numValidSolutions = 0;
+
+    std::pmr::vector<bool> alwaysMines(uncleared.size(), anyUnsatisfiable, resource);
+    std::pmr::vector<bool> alwaysClear(uncleared.size(), anyUnsatisfiable, resource);
+
+    for (size_t c = 0; c < histograms.size(); c++)
+    {
+        const Histogram& histogram = histograms[c];
+
+        // weight of a single configuration of this group with k mines,
+        // summed over every configuration of the other groups
+        std::pmr::vector<ScaledDouble> configWeights(histogram.configurations.size(), resource);
+        for (size_t k = 0; k < configWeights.size(); k++)
+            for (size_t j = 0; j < prefixes[c].size(); j++)
+                configWeights[k] += prefixes[c][j] * tails[c + 1][j + k];
+
+        const uint64_t groupSolutions = histogram.numConfigurations();
+
+        for (uint32_t i = 0; i < histogram.cells.size(); i++)
+        {
+            uint32_t idx = histogram.cells[i];
+            uint64_t cellHits = 0;
+            ScaledDouble prob = 0.0;
+            for (size_t k = 0; k < configWeights.size(); k++)
+            {
+                uint64_t hits = histogram.hits[k * histogram.cells.size() + i];
+                cellHits += hits;
+                prob += configWeights[k] * static_cast<double>(hits);
+            }
+            solution.mineProbs[idx].prob = (prob / totalWeight).toDouble();
+
+            // keep track of which cells were always mines/always clear
+            if (!histogram.exact)
+                continue;
+            if (cellHits == groupSolutions)
+                alwaysMines[idx] = true;
+            if (cellHits == 0)
+                alwaysClear[idx] = true;
+        }
+    }
+
+    // convert back from indices to squares
+    for (uint32_t i = 0; i < uncleared.size(); i++)
+        if (alwaysMines[i])
+            solution.mines.push_back(uncleared[i]);
+
+    for (uint32_t i = 0; i < uncleared.size(); i++)
+        if (alwaysClear[i])
+            solution.clears.push_back(uncleared[i]);
+
+    const auto remove = [&](const SolutionInfo::MineProb& mineProb)
+    {
+        return solution.isClear(mineProb.point) || solution.isMine(mineProb.point);
+    };
+    solution.mineProbs.erase(
+        std::remove_if(solution.mineProbs.begin(), solution.mineProbs.end(), remove),
+        solution.mineProbs.end());
+}
+
+inline SolutionInfo combine(std::span<const Point> uncleared,
+    std::span<const Histogram> histograms, uint32_t outsideMineCells, uint32_t availableMines)
+{
+    SolutionInfo solution = {};
+    combine(uncleared, histograms, outsideMineCells, availableMines, solution,
+        std::pmr::get_default_resource());
+    return solution;
+}
+
+}
@@ -0,0 +1,452 @@
+#pragma once
+
+#include "../board_image.h"
+#include "components.h"
+#include "mine_counts.h"
+#include "reduction.h"
+#include "solution_info.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace solvers::model_counting
+{
+
+// the cache is cleared once it holds this many residual formulas
+constexpr size_t MAX_CACHE_ENTRIES = 1 << 16;
+
+// Counts the valid configurations of the frontier like a #SAT solver counts models, with every
+// numbered cell as a cardinality constraint over its uncleared neighbors
+// Each step picks a cell, tries it as clear and as a mine, and assigns every cell a constraint
+// then forces. Whatever is left is split into components again, since assigning cells breaks
+// constraints apart, and each component is looked up in a cache keyed by its cells and the
+// mines its constraints still need, so residual formulas that come up again are only counted once
+// Counts are kept per mine total, in the same histograms the enumerating solvers produce
+class Counter
+{
+public:
+    Counter(uint32_t numCells, std::span<const components::FrontierConstraint> constraints);
+
+    // component has to come from components::split without being renumbered
+    // empty if the counts don't fit in 64 bits
+    std::optional<mine_counts::Histogram> count(const components::Component& component);
+
+    uint64_t decisions() const;
+    uint64_t cacheHits() const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const std::vector<uint32_t>& key) const noexcept
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            for (uint32_t value : key)
+            {
+                hash ^= value;
+                hash *= 0x100000001b3;
+            }
+            return hash;
+        }
+    };
+
+    // returns false on a contradiction
+    bool assign(uint32_t cell, bool mine);
+    bool propagate();
+    void undo(size_t trailSize);
+
+    // histogram of the unknown cells, which have to be closed under the constraints with
+    // unknown cells left
+    mine_counts::Histogram countResidual(const std::vector<uint32_t>& cells);
+    std::vector<std::vector<uint32_t>> splitResidual(const std::vector<uint32_t>& cells) const;
+    std::vector<uint32_t> cacheKey(const std::vector<uint32_t>& cells) const;
+    mine_counts::Histogram convolve(
+        const mine_counts::Histogram& a, const mine_counts::Histogram& b);
+    // adds the configurations of cells that extend the assignments made since trailSize
+    void addExtensions(mine_counts::Histogram& result, size_t trailSize);
+
+    void add(uint64_t& dst, uint64_t value);
+    void addProduct(uint64_t& dst, uint64_t a, uint64_t b);
+
+    std::span<const components::FrontierConstraint> m_Constraints;
+    std::vector<std::vector<uint32_t>> m_CellConstraints;
+
+    std::vector<reduction::CellValue> m_Values;
+    std::vector<int32_t> m_Needed;
+    std::vector<int32_t> m_Remaining;
+    // assigned cells in assignment order, so assignments can be undone
+    std::vector<uint32_t> m_Trail;
+    // constraints whose unknown cells are all mines or all clear
+    std::vector<uint32_t> m_Forced;
+
+    std::unordered_map<std::vector<uint32_t>, mine_counts::Histogram, KeyHash> m_Cache;
+    bool m_Overflow = false;
+    uint64_t m_Decisions = 0;
+    uint64_t m_CacheHits = 0;
+};
+
+inline Counter::Counter(
+    uint32_t numCells, std::span<const components::FrontierConstraint> constraints)
+    : m_Constraints(constraints),
+      m_CellConstraints(numCells),
+      m_Values(numCells, reduction::CellValue::UNKNOWN),
+      m_Needed(constraints.size()),
+      m_Remaining(constraints.size())
+{
+    for (uint32_t c = 0; c < constraints.size(); c++)
+    {
+        m_Needed[c] = constraints[c].sum;
+        m_Remaining[c] = constraints[c].indices.size();
+        for (uint32_t idx : constraints[c].indices)
+            m_CellConstraints[idx].push_back(c);
+    }
+}
+
+inline bool Counter::assign(uint32_t cell, bool mine)
+{
+    m_Values[cell] = mine ? reduction::CellValue::MINE : reduction::CellValue::CLEAR;
+    m_Trail.push_back(cell);
+    bool valid = true;
+    // every constraint is updated even after a contradiction so undo() can reverse it
+    for (uint32_t c : m_CellConstraints[cell])
+    {
+        m_Remaining[c]--;
+        m_Needed[c] -= mine;
+        if (m_Needed[c] < 0 || m_Needed[c] > m_Remaining[c])
+            valid = false;
+        else if (m_Remaining[c] > 0 && (m_Needed[c] == 0 || m_Needed[c] == m_Remaining[c]))
+            m_Forced.push_back(c);
+    }
+    return valid;
+}
+
+inline bool Counter::propagate()
+{
+    while (!m_Forced.empty())
+    {
+        const uint32_t c = m_Forced.back();
+        m_Forced.pop_back();
+        const bool mine = m_Needed[c] > 0;
+        for (uint32_t idx : m_Constraints[c].indices)
+        {
+            if (m_Values[idx] == reduction::CellValue::UNKNOWN && !assign(idx, mine))
+            {
+                m_Forced.clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline void Counter::undo(size_t trailSize)
+{
+    while (m_Trail.size() > trailSize)
+    {
+        const uint32_t cell = m_Trail.back();
+        m_Trail.pop_back();
+        const bool mine = m_Values[cell] == reduction::CellValue::MINE;
+        for (uint32_t c : m_CellConstraints[cell])
+        {
+            m_Remaining[c]++;
+            m_Needed[c] += mine;
+        }
+        m_Values[cell] = reduction::CellValue::UNKNOWN;
+    }
+}
+
+inline void Counter::add(uint64_t& dst, uint64_t value)
+{
+    m_Overflow |= value > UINT64_MAX - dst;
+    dst += value;
+}
+
+inline void Counter::addProduct(uint64_t& dst, uint64_t a, uint64_t b)
+{
+    m_Overflow |= b != 0 && a > UINT64_MAX / b;
+    add(dst, a * b);
+}
+
+// union-find over the constraints that still have unknown cells
+inline std::vector<std::vector<uint32_t>> Counter::splitResidual(
+    const std::vector<uint32_t>& cells) const
+{
+    const auto localIndex = [&](uint32_t cell)
+    {
+        return static_cast<uint32_t>(std::lower_bound(cells.begin(), cells.end(), cell)
+            - cells.begin());
+    };
+
+    std::vector<uint32_t> parents(cells.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (uint32_t i = 0; i < cells.size(); i++)
+    {
+        for (uint32_t c : m_CellConstraints[cells[i]])
+        {
+            for (uint32_t idx : m_Constraints[c].indices)
+            {
+                if (m_Values[idx] != reduction::CellValue::UNKNOWN)
+                    continue;
+                uint32_t a = components::findRoot(parents, i);
+                uint32_t b = components::findRoot(parents, localIndex(idx));
+                if (b < a)
+                    std::swap(a, b);
+                parents[b] = a;
+            }
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> groups;
+    std::vector<uint32_t> groupIndices(cells.size());
+    for (uint32_t i = 0; i < cells.size(); i++)
+    {
+        const uint32_t root = components::findRoot(parents, i);
+        if (root == i)
+        {
+            groupIndices[i] = groups.size();
+            groups.emplace_back();
+        }
+        else
+            groupIndices[i] = groupIndices[root];
+        groups[groupIndices[i]].push_back(cells[i]);
+    }
+    return groups;
+}
+
+// the cells, then every constraint with unknown cells as the mines it needs and its unknown cells
+inline std::vector<uint32_t> Counter::cacheKey(const std::vector<uint32_t>& cells) const
+{
+    std::vector<uint32_t> constraints;
+    for (uint32_t cell : cells)
+        constraints.insert(
+            constraints.end(), m_CellConstraints[cell].begin(), m_CellConstraints[cell].end());
+    std::sort(constraints.begin(), constraints.end());
+    constraints.erase(std::unique(constraints.begin(), constraints.end()), constraints.end());
+
+    std::vector<uint32_t> key = {static_cast<uint32_t>(cells.size())};
+    key.insert(key.end(), cells.begin(), cells.end());
+    std::vector<std::vector<uint32_t>> encoded;
+    for (uint32_t c : constraints)
+    {
+        std::vector<uint32_t>& constraint = encoded.emplace_back();
+        constraint.push_back(m_Needed[c]);
+        for (uint32_t idx : m_Constraints[c].indices)
+        {
+            if (m_Values[idx] == reduction::CellValue::UNKNOWN)
+                constraint.push_back(idx);
+        }
+        std::sort(constraint.begin() + 1, constraint.end());
+    }
+    // different constraints can leave the same residual constraint
+    std::sort(encoded.begin(), encoded.end());
+    encoded.erase(std::unique(encoded.begin(), encoded.end()), encoded.end());
+    for (const auto& constraint : encoded)
+    {
+        key.push_back(constraint.size());
+        key.insert(key.end(), constraint.begin(), constraint.end());
+    }
+    return key;
+}
+
+// histogram of the union of the cells of two independent histograms
+inline mine_counts::Histogram Counter::convolve(
+    const mine_counts::Histogram& a, const mine_counts::Histogram& b)
+{
+    std::vector<uint32_t> cells;
+    std::merge(a.cells.begin(), a.cells.end(), b.cells.begin(), b.cells.end(),
+        std::back_inserter(cells));
+    mine_counts::Histogram result(cells);
+    const uint32_t numCells = cells.size();
+
+    std::vector<uint32_t> positionsA;
+    for (uint32_t cell : a.cells)
+        positionsA.push_back(std::lower_bound(cells.begin(), cells.end(), cell) - cells.begin());
+    std::vector<uint32_t> positionsB;
+    for (uint32_t cell : b.cells)
+        positionsB.push_back(std::lower_bound(cells.begin(), cells.end(), cell) - cells.begin());
+
+    for (uint32_t i = 0; i < a.configurations.size(); i++)
+    {
+        if (a.configurations[i] == 0)
+            continue;
+        for (uint32_t j = 0; j < b.configurations.size(); j++)
+        {
+            if (b.configurations[j] == 0)
+                continue;
+            addProduct(result.configurations[i + j], a.configurations[i], b.configurations[j]);
+            uint64_t* hits = &result.hits[(i + j) * numCells];
+            const uint64_t* hitsA = &a.hits[i * a.cells.size()];
+            const uint64_t* hitsB = &b.hits[j * b.cells.size()];
+            for (uint32_t x = 0; x < a.cells.size(); x++)
+                addProduct(hits[positionsA[x]], hitsA[x], b.configurations[j]);
+            for (uint32_t x = 0; x < b.cells.size(); x++)
+                addProduct(hits[positionsB[x]], a.configurations[i], hitsB[x]);
+        }
+    }
+    return result;
+}
+
+inline void Counter::addExtensions(mine_counts::Histogram& result, size_t trailSize)
+{
+    const std::pmr::vector<uint32_t>& cells = result.cells;
+    const uint32_t numCells = cells.size();
+    const auto position = [&](uint32_t cell)
+    {
+        return std::lower_bound(cells.begin(), cells.end(), cell) - cells.begin();
+    };
+
+    std::vector<uint32_t> rest;
+    for (uint32_t cell : cells)
+    {
+        if (m_Values[cell] == reduction::CellValue::UNKNOWN)
+            rest.push_back(cell);
+    }
+    const mine_counts::Histogram sub = countResidual(rest);
+
+    std::vector<uint32_t> forcedMines;
+    for (size_t i = trailSize; i < m_Trail.size(); i++)
+    {
+        if (m_Values[m_Trail[i]] == reduction::CellValue::MINE)
+            forcedMines.push_back(position(m_Trail[i]));
+    }
+    std::vector<uint32_t> restPositions;
+    for (uint32_t cell : rest)
+        restPositions.push_back(position(cell));
+
+    const uint32_t shift = forcedMines.size();
+    for (uint32_t k = 0; k < sub.configurations.size(); k++)
+    {
+        if (sub.configurations[k] == 0)
+            continue;
+        add(result.configurations[k + shift], sub.configurations[k]);
+        uint64_t* hits = &result.hits[(k + shift) * numCells];
+        for (uint32_t pos : forcedMines)
+            add(hits[pos], sub.configurations[k]);
+        for (uint32_t i = 0; i < rest.size(); i++)
+            add(hits[restPositions[i]], sub.hits[k * rest.size() + i]);
+    }
+}
+
+inline mine_counts::Histogram Counter::countResidual(const std::vector<uint32_t>& cells)
+{
+    if (cells.empty())
+    {
+        mine_counts::Histogram histogram(cells);
+        histogram.configurations[0] = 1;
+        return histogram;
+    }
+
+    std::vector<uint32_t> key = cacheKey(cells);
+    auto it = m_Cache.find(key);
+    if (it != m_Cache.end())
+    {
+        m_CacheHits++;
+        return it->second;
+    }
+
+    std::vector<std::vector<uint32_t>> groups = splitResidual(cells);
+    mine_counts::Histogram result(cells);
+    if (groups.size() > 1)
+    {
+        result = countResidual(groups[0]);
+        for (size_t i = 1; i < groups.size(); i++)
+            result = convolve(result, countResidual(groups[i]));
+    }
+    else
+    {
+        // branch on the cell in the most constraints, so the formula falls apart the fastest
+        uint32_t branchCell = cells[0];
+        size_t mostConstraints = 0;
+        for (uint32_t cell : cells)
+        {
+            size_t numConstraints = 0;
+            for (uint32_t c : m_CellConstraints[cell])
+                numConstraints += m_Remaining[c] > 0;
+            if (numConstraints > mostConstraints)
+            {
+                mostConstraints = numConstraints;
+                branchCell = cell;
+            }
+        }
+
+        m_Decisions++;
+        for (bool mine : {false, true})
+        {
+            const size_t trailSize = m_Trail.size();
+            if (assign(branchCell, mine) && propagate())
+                addExtensions(result, trailSize);
+            m_Forced.clear();
+            undo(trailSize);
+        }
+    }
+
+    if (m_Cache.size() >= MAX_CACHE_ENTRIES)
+        m_Cache.clear();
+    m_Cache.insert({std::move(key), result});
+    return result;
+}
+
+inline std::optional<mine_counts::Histogram> Counter::count(const components::Component& component)
+{
+    const std::span<const uint32_t> cells = component.cells;
+    mine_counts::Histogram result(cells);
+
+    // a component without cells holds a constraint without cells that still needs mines,
+    // which no configuration satisfies
+    if (cells.empty())
+        return result;
+
+    // constraints that are already forced before anything is assigned
+    const size_t trailSize = m_Trail.size();
+    bool valid = true;
+    for (uint32_t cell : cells)
+    {
+        for (uint32_t c : m_CellConstraints[cell])
+        {
+            valid &= m_Needed[c] >= 0 && m_Needed[c] <= m_Remaining[c];
+            if (m_Needed[c] == 0 || m_Needed[c] == m_Remaining[c])
+                m_Forced.push_back(c);
+        }
+    }
+    if (valid && propagate())
+        addExtensions(result, trailSize);
+    m_Forced.clear();
+    undo(trailSize);
+
+    if (m_Overflow)
+        return {};
+    return result;
+}
+
+inline uint64_t Counter::decisions() const
+{
+    return m_Decisions;
+}
+
+inline uint64_t Counter::cacheHits() const
+{
+    return m_CacheHits;
+}
+
+inline std::optional<SolutionInfo> solve(const BoardImage& image)
+{
+    const components::Frontier frontier = components::buildFrontier(image);
+    Counter counter(frontier.cells.size(), frontier.constraints);
+    std::vector<mine_counts::Histogram> histograms;
+    for (const auto& component : components::split(frontier.cells.size(), frontier.constraints))
+    {
+        std::optional<mine_counts::Histogram> histogram = counter.count(component);
+        if (!histogram)
+            return {};
+        histograms.push_back(std::move(histogram.value()));
+    }
+
+    return {mine_counts::combine(
+        frontier.cells, histograms, frontier.outsideCells, image.numMines())};
+}
+
+}
@@ -0,0 +1,439 @@
+#pragma once
+
+#include "../util/static_vector.h"
+#include "components.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace solvers::reduction
+{
+
+enum class CellValue : uint8_t
+{
+    UNKNOWN,
+    CLEAR,
+    MINE
+};
+
+// Deduces cells that are the same in every valid configuration before enumerating
+// Constraints are processed from a worklist, and only constraints that touch a newly solved
+// cell (or share cells with a changed constraint) are looked at again
+// Once the local rules run out, Gaussian elimination over each group of remaining constraints
+// that share cells looks for deductions that need more than two constraints at a time
+class Reducer
+{
+public:
+    // everything the reducer allocates comes from resource
+    Reducer(uint32_t numCells, std::span<const components::FrontierConstraint> constraints,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void run();
+
+    const std::pmr::vector<CellValue>& values() const;
+    // constraints that still have unknown cells, with the known cells removed
+    // constraints that are linear combinations of the others are left out
+    std::pmr::vector<components::FrontierConstraint> remainingConstraints() const;
+
+private:
+    struct ConstraintState
+    {
+        // cells that are not known yet
+        StaticVector<uint32_t, 8> unknown;
+        // number of mines in those cells
+        int32_t needed;
+        bool queued;
+        bool redundant;
+    };
+
+    void runLocal();
+    bool eliminate();
+    // columns maps cells to matrix columns, UINT32_MAX for every cell before and after
+    bool eliminateGroup(std::span<uint32_t> rowConstraints, std::span<uint32_t> columns,
+        std::pmr::vector<std::pair<uint32_t, CellValue>>& forced);
+
+    void queue(uint32_t constraintIdx);
+    void setCell(uint32_t cell, CellValue value);
+    void setCells(const StaticVector<uint32_t, 8>& cells, CellValue value);
+    void applySingle(uint32_t constraintIdx);
+    void applyPair(uint32_t a, uint32_t b);
+
+    std::pmr::memory_resource* m_Resource;
+    std::pmr::vector<CellValue> m_Values;
+    std::pmr::vector<ConstraintState> m_Constraints;
+    // constraints each cell is part of
+    std::pmr::vector<StaticVector<uint32_t, 8>> m_CellConstraints;
+    std::pmr::vector<uint32_t> m_Worklist;
+    // a constraint that can't be satisfied anymore, there is nothing to deduce
+    bool m_Contradiction = false;
+};
+
+inline Reducer::Reducer(uint32_t numCells,
+    std::span<const components::FrontierConstraint> constraints,
+    std::pmr::memory_resource* resource)
+    : m_Resource(resource),
+      m_Values(numCells, CellValue::UNKNOWN, resource),
+      m_Constraints(resource),
+      m_CellConstraints(numCells, resource),
+      m_Worklist(resource)
+{
+    m_Constraints.reserve(constraints.size());
+    for (uint32_t i = 0; i < constraints.size(); i++)
+    {
+        m_Constraints.push_back(
+            {constraints[i].indices, static_cast<int32_t>(constraints[i].sum), false, false});
+        for (uint32_t cell : constraints[i].indices)
+            m_CellConstraints[cell].push_back(i);
+    }
+}
+
+inline void Reducer::run()
+{
+    for (uint32_t i = 0; i < m_Constraints.size(); i++)
+        queue(i);
+
+    // elimination is much more expensive, so only use it when the local rules are stuck
+    // anything it solves requeues constraints for the local rules again
+    do
+        runLocal();
+    while (!m_Contradiction && eliminate());
+}
+
+inline void Reducer::runLocal()
+{
+    while (!m_Worklist.empty() && !m_Contradiction)
+    {
+        uint32_t constraintIdx = m_Worklist.back();
+        m_Worklist.pop_back();
+        m_Constraints[constraintIdx].queued = false;
+
+        applySingle(constraintIdx);
+
+        // compare against every constraint sharing a cell with this one
+        StaticVector<uint32_t, 64> neighbors;
+        for (uint32_t cell : m_Constraints[constraintIdx].unknown)
+        {
+            for (uint32_t other : m_CellConstraints[cell])
+            {
+                if (other != constraintIdx
+                    && std::find(neighbors.begin(), neighbors.end(), other) == neighbors.end())
+                    neighbors.push_back(other);
+            }
+        }
+        for (uint32_t other : neighbors)
+        {
+            applyPair(constraintIdx, other);
+            applyPair(other, constraintIdx);
+        }
+    }
+}
+
+inline const std::pmr::vector<CellValue>& Reducer::values() const
+{
+    return m_Values;
+}
+
+inline std::pmr::vector<components::FrontierConstraint> Reducer::remainingConstraints() const
+{
+    std::pmr::vector<components::FrontierConstraint> result(m_Resource);
+    for (const auto& state : m_Constraints)
+    {
+        // solved constraints are dropped, unless they are contradictory
+        if (state.unknown.size() == 0 && state.needed == 0)
+            continue;
+        if (state.redundant)
+            continue;
+        // negative sums can never be satisfied, any sum larger than the cell count works for that
+        uint32_t sum = state.needed < 0 ? 9 : static_cast<uint32_t>(state.needed);
+        result.push_back({state.unknown, sum});
+    }
+    return result;
+}
+
+inline void Reducer::queue(uint32_t constraintIdx)
+{
+    if (m_Constraints[constraintIdx].queued)
+        return;
+    m_Constraints[constraintIdx].queued = true;
+    m_Worklist.push_back(constraintIdx);
+}
+
+inline void Reducer::setCell(uint32_t cell, CellValue value)
+{
+    if (m_Values[cell] != CellValue::UNKNOWN)
+        return;
+    m_Values[cell] = value;
+
+    // remove the cell from its constraints, and requeue them since they changed
+    for (uint32_t constraintIdx : m_CellConstraints[cell])
+    {
+        ConstraintState& state = m_Constraints[constraintIdx];
+        auto it = std::find(state.unknown.begin(), state.unknown.end(), cell);
+        *it = state.unknown[state.unknown.size() - 1];
+        state.unknown.resize(state.unknown.size() - 1);
+        state.needed -= value == CellValue::MINE;
+
+        if (state.needed < 0 || state.needed > static_cast<int32_t>(state.unknown.size()))
+            m_Contradiction = true;
+        queue(constraintIdx);
+    }
+}
+
+inline void Reducer::setCells(const StaticVector<uint32_t, 8>& cells, CellValue value)
+{
+    for (uint32_t cell : cells)
+        setCell(cell, value);
+}
+
+// guaranteed mine
+// ..O
+// .1.
+// ...
+
+// X = mine
+// guaranteed clear
+// ..X
+// .1O
+// ..O
+inline void Reducer::applySingle(uint32_t constraintIdx)
+{
+    // copy since setting cells modifies the constraint
+    const ConstraintState state = m_Constraints[constraintIdx];
+    if (state.unknown.size() == 0)
+        return;
+
+    // all cells that are not already known are mines
+    if (state.needed == static_cast<int32_t>(state.unknown.size()))
+        setCells(state.unknown, CellValue::MINE);
+    // all cells that are not already known are clear
+    else if (state.needed == 0)
+        setCells(state.unknown, CellValue::CLEAR);
+}
+
+// Looks at the cells of b that are not in a
+// a can put at most min(needed(a), |a & b|) mines in the shared cells, so if the rest of b
+// needs every one of its cells, they are all mines (the 1-2 pattern)
+// a puts at least needed(a) - |a - b| mines in the shared cells, so if that already covers
+// everything b needs, the rest of b is clear (the 1-1 pattern)
+// If a is a subset of b, both of these are exact
+inline void Reducer::applyPair(uint32_t a, uint32_t b)
+{
+    const ConstraintState& stateA = m_Constraints[a];
+    const ConstraintState& stateB = m_Constraints[b];
+
+    int32_t shared = 0;
+    StaticVector<uint32_t, 8> onlyB;
+    for (uint32_t cell : stateB.unknown)
+    {
+        if (std::find(stateA.unknown.begin(), stateA.unknown.end(), cell) != stateA.unknown.end())
+            shared++;
+        else
+            onlyB.push_back(cell);
+    }
+    if (shared == 0 || onlyB.size() == 0)
+        return;
+
+    const int32_t onlyA = static_cast<int32_t>(stateA.unknown.size()) - shared;
+    const int32_t maxShared = std::min(stateA.needed, shared);
+    const int32_t minShared = std::max(0, stateA.needed - onlyA);
+
+    if (stateB.needed - maxShared == static_cast<int32_t>(onlyB.size()))
+        setCells(onlyB, CellValue::MINE);
+    else if (stateB.needed - minShared == 0)
+        setCells(onlyB, CellValue::CLEAR);
+}
+
+// Splits the remaining constraints into groups that share cells and eliminates each group on its
+// own, so the dense matrices are only as large as a single group
+// returns true if any new cell was solved
+inline bool Reducer::eliminate()
+{
+    std::pmr::vector<uint32_t> parents(m_Values.size(), m_Resource);
+    std::iota(parents.begin(), parents.end(), 0);
+    std::pmr::vector<uint32_t> rowConstraints(m_Resource);
+    for (uint32_t i = 0; i < m_Constraints.size(); i++)
+    {
+        const ConstraintState& state = m_Constraints[i];
+        if (state.unknown.size() == 0 || state.redundant)
+            continue;
+        rowConstraints.push_back(i);
+        const uint32_t root = components::findRoot(parents, state.unknown[0]);
+        for (uint32_t cell : state.unknown)
+            parents[components::findRoot(parents, cell)] = root;
+    }
+
+    // constraints of the same group next to each other, in their original order
+    std::pmr::vector<std::pair<uint32_t, uint32_t>> keyed(m_Resource);
+    for (uint32_t idx : rowConstraints)
+        keyed.push_back({components::findRoot(parents, m_Constraints[idx].unknown[0]), idx});
+    std::sort(keyed.begin(), keyed.end());
+    for (uint32_t i = 0; i < keyed.size(); i++)
+        rowConstraints[i] = keyed[i].second;
+
+    std::pmr::vector<uint32_t> columns(m_Values.size(), UINT32_MAX, m_Resource);
+    std::pmr::vector<std::pair<uint32_t, CellValue>> forced(m_Resource);
+    for (uint32_t begin = 0; begin < keyed.size();)
+    {
+        uint32_t end = begin + 1;
+        while (end < keyed.size() && keyed[end].first == keyed[begin].first)
+            end++;
+        const auto group = std::span(rowConstraints).subspan(begin, end - begin);
+        if (!eliminateGroup(group, columns, forced))
+        {
+            m_Contradiction = true;
+            return false;
+        }
+        begin = end;
+    }
+
+    for (auto [cell, value] : forced)
+        setCell(cell, value);
+    return !forced.empty();
+}
+
+// Brings a group of constraints into reduced row echelon form with integer row operations
+// Each reduced row is sum(c_i * x_i) = b with x_i in {0, 1}, so the left side lies between the
+// sum of the negative and the sum of the positive coefficients
+// If b is at either end of that range, every cell in the row is forced,
+// e.g. x_0 + x_1 - x_2 = 2 means x_0 and x_1 are mines and x_2 is clear
+// Rows that reduce to 0 = 0 are linear combinations of the other constraints and are marked
+// redundant, they can't rule out any configuration the others allow
+// adds the forced cells to forced, and returns false if the constraints contradict each other
+inline bool Reducer::eliminateGroup(std::span<uint32_t> rowConstraints,
+    std::span<uint32_t> columns, std::pmr::vector<std::pair<uint32_t, CellValue>>& forced)
+{
+    // the coefficients are kept small by dividing each row by its gcd
+    // if they grow anyway, give up on the group, which keeps the sums of a row far from overflow
+    constexpr int64_t MAX_COEFFICIENT = 1ll << 40;
+
+    // cells get columns in the order the constraints reach them
+    std::pmr::vector<uint32_t> cells(m_Resource);
+    for (uint32_t idx : rowConstraints)
+    {
+        for (uint32_t cell : m_Constraints[idx].unknown)
+        {
+            if (columns[cell] == UINT32_MAX)
+            {
+                columns[cell] = cells.size();
+                cells.push_back(cell);
+            }
+        }
+    }
+
+    // the last column of each row is the sum
+    const uint32_t numCols = cells.size();
+    const uint32_t rowSize = numCols + 1;
+    std::pmr::vector<int64_t> matrix(rowConstraints.size() * rowSize, m_Resource);
+    for (uint32_t row = 0; row < rowConstraints.size(); row++)
+    {
+        const ConstraintState& state = m_Constraints[rowConstraints[row]];
+        for (uint32_t cell : state.unknown)
+            matrix[row * rowSize + columns[cell]] = 1;
+        matrix[row * rowSize + numCols] = state.needed;
+    }
+    for (uint32_t cell : cells)
+        columns[cell] = UINT32_MAX;
+
+    // row = a * row - b * pivotRow, with a and b chosen so that col becomes 0
+    // returns false without finishing the row if a coefficient would overflow
+    auto eliminateColumn = [&](uint32_t row, uint32_t pivotRow, uint32_t col)
+    {
+        int64_t* dst = &matrix[row * rowSize];
+        const int64_t* src = &matrix[pivotRow * rowSize];
+        const int64_t g = std::gcd(dst[col], src[col]);
+        const int64_t a = src[col] / g;
+        const int64_t b = dst[col] / g;
+        int64_t rowGcd = 0;
+        for (uint32_t i = 0; i < rowSize; i++)
+        {
+            int64_t scaledDst;
+            int64_t scaledSrc;
+            if (__builtin_mul_overflow(a, dst[i], &scaledDst)
+                || __builtin_mul_overflow(b, src[i], &scaledSrc)
+                || __builtin_sub_overflow(scaledDst, scaledSrc, &dst[i])
+                || std::abs(dst[i]) > MAX_COEFFICIENT)
+                return false;
+            rowGcd = std::gcd(rowGcd, dst[i]);
+        }
+        if (rowGcd > 1)
+        {
+            for (uint32_t i = 0; i < rowSize; i++)
+                dst[i] /= rowGcd;
+        }
+        return true;
+    };
+
+    uint32_t pivotRow = 0;
+    for (uint32_t col = 0; col < numCols && pivotRow < rowConstraints.size(); col++)
+    {
+        uint32_t row = pivotRow;
+        while (row < rowConstraints.size() && matrix[row * rowSize + col] == 0)
+            row++;
+        if (row == rowConstraints.size())
+            continue;
+
+        if (row != pivotRow)
+        {
+            std::swap_ranges(&matrix[row * rowSize], &matrix[(row + 1) * rowSize],
+                &matrix[pivotRow * rowSize]);
+            std::swap(rowConstraints[row], rowConstraints[pivotRow]);
+        }
+
+        // eliminate above as well, so the forced cell checks see fully reduced rows
+        for (uint32_t other = 0; other < rowConstraints.size(); other++)
+        {
+            if (other == pivotRow || matrix[other * rowSize + col] == 0)
+                continue;
+            // nothing can be deduced from a partly eliminated group
+            if (!eliminateColumn(other, pivotRow, col))
+                return true;
+        }
+        pivotRow++;
+    }
+
+    // every row from pivotRow on is all zero in the cell columns
+    for (uint32_t row = pivotRow; row < rowConstraints.size(); row++)
+    {
+        if (matrix[row * rowSize + numCols] != 0)
+            return false;
+        m_Constraints[rowConstraints[row]].redundant = true;
+    }
+
+    for (uint32_t row = 0; row < pivotRow; row++)
+    {
+        const int64_t* coefficients = &matrix[row * rowSize];
+        int64_t minSum = 0;
+        int64_t maxSum = 0;
+        for (uint32_t col = 0; col < numCols; col++)
+        {
+            if (coefficients[col] < 0)
+                minSum += coefficients[col];
+            else
+                maxSum += coefficients[col];
+        }
+
+        const int64_t sum = coefficients[numCols];
+        if (sum < minSum || sum > maxSum)
+            return false;
+        if (sum != minSum && sum != maxSum)
+            continue;
+
+        // at the minimum, positive coefficients are clear and negative ones are mines
+        const bool positiveMines = sum == maxSum;
+        for (uint32_t col = 0; col < numCols; col++)
+        {
+            if (coefficients[col] == 0)
+                continue;
+            const bool mine = (coefficients[col] > 0) == positiveMines;
+            forced.push_back({cells[col], mine ? CellValue::MINE : CellValue::CLEAR});
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "../board_image.h"
+#include "../util/parallel.h"
+#include "basic_optimized.h"
+#include "components.h"
+#include "frontier_dp.h"
+#include "solution_info.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace solvers::sampling
+{
+
+// cells re-sampled together by a single update, halved until the sweep over them fits
+constexpr uint32_t BLOCK_CELLS = 48;
+// search nodes a chain may spend finding a starting configuration for one component
+constexpr uint64_t MAX_INIT_NODES = 1'000'000;
+
+struct Options
+{
+    uint32_t numChains = 4;
+    uint32_t numThreads = std::thread::hardware_concurrency();
+    // sweeps thrown away before a chain starts recording
+    uint32_t burnIn = 200;
+    // sweeps recorded per chain, a sweep updates about every frontier cell once
+    uint32_t samplesPerChain = 1000;
+    uint64_t seed = 0;
+};
+
+struct Diagnostics
+{
+    // Gelman-Rubin potential scale reduction of the mine probability, the largest of any cell
+    // close to 1 when the chains agree with each other, well above 1 if they haven't mixed
+    // NaN with fewer than two chains
+    double maxRHat = 0.0;
+    // chains that found a starting configuration
+    uint32_t numChains = 0;
+    // fraction of the proposed block updates that were accepted
+    double acceptanceRate = 0.0;
+};
+
+// the frontier cells that are still unknown after reduction, and their constraints
+struct Problem
+{
+    uint32_t numCells;
+    std::vector<components::FrontierConstraint> constraints;
+    std::vector<std::vector<uint32_t>> cellConstraints;
+    // cells of each component in Cuthill-McKee order, so any interval of them is a narrow band
+    std::vector<std::vector<uint32_t>> components;
+    // logWeights[m] = log of the number of ways to place the other mines outside the frontier
+    // when there are m mines in it, -infinity if they don't fit
+    std::vector<double> logWeights;
+    uint32_t availableMines;
+};
+
+// A Markov chain over the mine configurations of the frontier
+// Each update picks a random interval of up to BLOCK_CELLS cells of a component and
+// proposes new values for all of them at once, drawn with frontier_dp::ComponentSweep from
+// every assignment that keeps the constraints satisfied. The proposal weighs each mine by
+// the outside weight ratio around the current mine count, and a Metropolis-Hastings step
+// corrects that to the exact number of ways to place the remaining mines outside, so every
+// configuration is visited in proportion to the number of full boards it stands for
+class Chain
+{
+public:
+    Chain(const Problem& problem, uint64_t seed);
+
+    // random valid starting configuration, false if none was found
+    bool init();
+    void sweep();
+
+    const std::vector<uint8_t>& mines() const;
+    uint32_t numMines() const;
+    uint64_t proposals() const;
+    uint64_t accepted() const;
+
+private:
+    static constexpr uint32_t NOT_IN_BLOCK = UINT32_MAX;
+
+    // depth first search for a valid assignment of cells[i..], trying values in random order
+    // false if there is none or the search ran out of nodes
+    bool findConfiguration(const std::vector<uint32_t>& cells, uint32_t i);
+    void update(uint32_t component);
+    // false if too many constraints are open at once within the interval
+    bool resample(const std::vector<uint32_t>& order, uint32_t start, uint32_t length);
+
+    const Problem& m_Problem;
+    std::mt19937_64 m_Rng;
+
+    std::vector<uint8_t> m_Mines;
+    uint32_t m_NumMines = 0;
+    uint64_t m_Proposals = 0;
+    uint64_t m_Accepted = 0;
+
+    // mines each constraint still needs and its cells that are still unassigned while
+    // searching for a starting configuration
+    std::vector<int32_t> m_Needed;
+    std::vector<int32_t> m_Remaining;
+    uint64_t m_Nodes = 0;
+
+    // scratch for resample()
+    std::vector<uint32_t> m_BlockIndices;
+    std::vector<uint32_t> m_ConstraintStamps;
+    uint32_t m_Stamp = 0;
+    std::vector<uint8_t> m_Proposal;
+};
+
+inline Chain::Chain(const Problem& problem, uint64_t seed)
+    : m_Problem(problem),
+      m_Rng(seed),
+      m_Mines(problem.numCells),
+      m_Needed(problem.constraints.size()),
+      m_Remaining(problem.constraints.size()),
+      m_BlockIndices(problem.numCells, NOT_IN_BLOCK),
+      m_ConstraintStamps(problem.constraints.size())
+{
+}
+
+inline bool Chain::findConfiguration(const std::vector<uint32_t>& cells, uint32_t i)
+{
+    if (i == cells.size())
+        return true;
+    if (++m_Nodes > MAX_INIT_NODES)
+        return false;
+
+    const uint32_t cell = cells[i];
+    const bool first = m_Rng() & 1;
+    for (bool mine : {first, !first})
+    {
+        bool fits = true;
+        for (uint32_t c : m_Problem.cellConstraints[cell])
+        {
+            const int32_t needed = m_Needed[c] - mine;
+            fits &= needed >= 0 && needed <= m_Remaining[c] - 1;
+        }
+        if (!fits)
+            continue;
+
+        for (uint32_t c : m_Problem.cellConstraints[cell])
+        {
+            m_Needed[c] -= mine;
+            m_Remaining[c]--;
+        }
+        if (findConfiguration(cells, i + 1))
+        {
+            m_Mines[cell] = mine;
+            return true;
+        }
+        for (uint32_t c : m_Problem.cellConstraints[cell])
+        {
+            m_Needed[c] += mine;
+            m_Remaining[c]++;
+        }
+        if (m_Nodes > MAX_INIT_NODES)
+            return false;
+    }
+    return false;
+}
+
+inline bool Chain::init()
+{
+    for (uint32_t c = 0; c < m_Problem.constraints.size(); c++)
+    {
+        m_Needed[c] = m_Problem.constraints[c].sum;
+        m_Remaining[c] = m_Problem.constraints[c].indices.size();
+    }
+
+    for (const auto& cells : m_Problem.components)
+    {
+        m_Nodes = 0;
+        if (!findConfiguration(cells, 0))
+            return false;
+    }
+
+    m_NumMines = std::count(m_Mines.begin(), m_Mines.end(), 1);
+    return true;
+}
+
+inline bool Chain::resample(const std::vector<uint32_t>& order, uint32_t start, uint32_t length)
+{
+    // the block as a component of its own, each constraint touching it needs the mines
+    // the cells outside of the block don't have
+    components::Component block;
+    block.cells.assign(order.begin() + start, order.begin() + start + length);
+    uint32_t blockMines = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        m_BlockIndices[block.cells[i]] = i;
+        blockMines += m_Mines[block.cells[i]];
+    }
+
+    m_Stamp++;
+    for (uint32_t cell : block.cells)
+    {
+        for (uint32_t c : m_Problem.cellConstraints[cell])
+        {
+            if (m_ConstraintStamps[c] == m_Stamp)
+                continue;
+            m_ConstraintStamps[c] = m_Stamp;
+
+            components::FrontierConstraint constraint = {};
+            constraint.sum = m_Problem.constraints[c].sum;
+            for (uint32_t idx : m_Problem.constraints[c].indices)
+            {
+                if (m_BlockIndices[idx] != NOT_IN_BLOCK)
+                    constraint.indices.push_back(m_BlockIndices[idx]);
+                else
+                    constraint.sum -= m_Mines[idx];
+            }
+            block.constraints.push_back(constraint);
+        }
+    }
+    for (uint32_t cell : block.cells)
+        m_BlockIndices[cell] = NOT_IN_BLOCK;
+
+    // log of the outside weight ratio between one more and one less mine near the mine count
+    // of the other cells, 0 if there is no such pair of mine counts
+    const uint32_t otherMines = m_NumMines - blockMines;
+    const std::vector<double>& logWeights = m_Problem.logWeights;
+    double logRatio = 0.0;
+    for (uint32_t k = 0; k < length; k++)
+    {
+        if (std::isfinite(logWeights[otherMines + k])
+            && std::isfinite(logWeights[otherMines + k + 1]))
+        {
+            logRatio = logWeights[otherMines + k + 1] - logWeights[otherMines + k];
+            break;
+        }
+    }
+
+    frontier_dp::ComponentSweep sweep(block);
+    if (!sweep.sample(std::exp(logRatio), m_Rng, m_Proposal))
+        return false;
+
+    const uint32_t proposedMines = std::count(m_Proposal.begin(), m_Proposal.end(), 1);
+    // the proposal only depends on the cells outside the block, so its ratio for the
+    // current and proposed assignment is the ratio of their mine weights
+    const double logAcceptance = logWeights[otherMines + proposedMines] - logWeights[m_NumMines]
+        - (static_cast<double>(proposedMines) - blockMines) * logRatio;
+    m_Proposals++;
+    if (std::log(std::uniform_real_distribution<double>(0.0, 1.0)(m_Rng)) < logAcceptance)
+    {
+        m_Accepted++;
+        for (uint32_t i = 0; i < length; i++)
+            m_Mines[block.cells[i]] = m_Proposal[i];
+        m_NumMines = otherMines + proposedMines;
+    }
+    return true;
+}
+
+inline void Chain::update(uint32_t component)
+{
+    const std::vector<uint32_t>& order = m_Problem.components[component];
+    const uint32_t size = order.size();
+    const uint32_t position = std::uniform_int_distribution<uint32_t>(0, size - 1)(m_Rng);
+
+    // a random interval of the component containing the cell at position
+    // the interval never depends on the current configuration, which keeps the chain reversible
+    for (uint32_t length = std::min(BLOCK_CELLS, size); length > 0; length /= 2)
+    {
+        const uint32_t first = position + 1 >= length ? position + 1 - length : 0;
+        const uint32_t last = std::min(position, size - length);
+        const uint32_t start = std::uniform_int_distribution<uint32_t>(first, last)(m_Rng);
+        if (resample(order, start, length))
+            return;
+    }
+}
+
+inline void Chain::sweep()
+{
+    for (uint32_t component = 0; component < m_Problem.components.size(); component++)
+    {
+        const uint32_t size = m_Problem.components[component].size();
+        for (uint32_t i = 0; i < (size + BLOCK_CELLS - 1) / BLOCK_CELLS; i++)
+            update(component);
+    }
+}
+
+inline const std::vector<uint8_t>& Chain::mines() const
+{
+    return m_Mines;
+}
+
+inline uint32_t Chain::numMines() const
+{
+    return m_NumMines;
+}
+
+inline uint64_t Chain::proposals() const
+{
+    return m_Proposals;
+}
+
+inline uint64_t Chain::accepted() const
+{
+    return m_Accepted;
+}
+
+// Estimates the mine probabilities of image with options.numChains independent chains
+// Everything the reducer can deduce is still exact, the rest of the solution is approximate:
+// probError is the standard error of the mean over the chains, and no cell is reported as
+// always a mine or always clear from the samples
+// empty if no chain found a starting configuration
+inline std::optional<SolutionInfo> solve(
+    const BoardImage& image, const Options& options = {}, Diagnostics* diagnostics = nullptr)
+{
+    const components::Frontier frontier = components::buildFrontier(image);
+    basic_optimized::ReducedFrontier reduced =
+        basic_optimized::reduceFrontier(frontier.cells, frontier.constraints);
+    const basic_optimized::FrontierSolution& result = reduced.solution;
+    const uint32_t outsideMineCells = frontier.outsideCells;
+
+    Problem problem = {};
+    problem.numCells = result.uncleared.size();
+    problem.availableMines = image.numMines() - result.knownMines.size();
+    problem.cellConstraints.resize(problem.numCells);
+    for (const auto& component : reduced.components)
+    {
+        std::vector<uint32_t>& order = problem.components.emplace_back();
+        for (uint32_t idx : components::cuthillMcKee(component))
+            order.push_back(component.cells[idx]);
+        for (auto constraint : component.constraints)
+        {
+            for (uint32_t& idx : constraint.indices)
+            {
+                idx = component.cells[idx];
+                problem.cellConstraints[idx].push_back(problem.constraints.size());
+            }
+            problem.constraints.push_back(constraint);
+        }
+    }
+    // log (outside choose available - m)
+    for (uint32_t m = 0; m <= problem.numCells; m++)
+    {
+        const int64_t outsideMines = static_cast<int64_t>(problem.availableMines) - m;
+        if (outsideMines < 0 || outsideMines > outsideMineCells)
+            problem.logWeights.push_back(-std::numeric_limits<double>::infinity());
+        else
+            problem.logWeights.push_back(std::lgamma(outsideMineCells + 1.0)
+                - std::lgamma(outsideMines + 1.0)
+                - std::lgamma(outsideMineCells - outsideMines + 1.0));
+    }
+
+    // hits[chain][i] = recorded sweeps where cell i was a mine
+    std::vector<std::vector<uint64_t>> hits(
+        options.numChains, std::vector<uint64_t>(problem.numCells));
+    std::vector<double> outsideMines(options.numChains);
+    std::vector<uint8_t> initialized(options.numChains);
+    std::vector<uint64_t> proposals(options.numChains);
+    std::vector<uint64_t> accepted(options.numChains);
+    parallelFor(options.numChains, std::max(1u, options.numThreads),
+        [&](uint32_t, uint64_t chainIdx)
+        {
+            Chain chain(problem, options.seed + chainIdx * 0x9e3779b97f4a7c15);
+            if (problem.numCells > 0 && !chain.init())
+                return;
+            initialized[chainIdx] = true;
+            if (problem.numCells == 0)
+            {
+                outsideMines[chainIdx] = problem.availableMines;
+                return;
+            }
+
+            for (uint32_t i = 0; i < options.burnIn; i++)
+                chain.sweep();
+            for (uint32_t i = 0; i < options.samplesPerChain; i++)
+            {
+                chain.sweep();
+                const std::vector<uint8_t>& mines = chain.mines();
+                for (uint32_t cell = 0; cell < problem.numCells; cell++)
+                    hits[chainIdx][cell] += mines[cell];
+                outsideMines[chainIdx] +=
+                    static_cast<double>(problem.availableMines) - chain.numMines();
+            }
+            outsideMines[chainIdx] /= options.samplesPerChain;
+            proposals[chainIdx] = chain.proposals();
+            accepted[chainIdx] = chain.accepted();
+        });
+
+    std::vector<uint32_t> chains;
+    for (uint32_t i = 0; i < options.numChains; i++)
+    {
+        if (initialized[i])
+            chains.push_back(i);
+    }
+    if (chains.empty())
+        return {};
+
+    SolutionInfo solution = {};
+    solution.exact = false;
+    solution.numValidSolutions = 0;
+    solution.initMineProbs(result.uncleared);
+    solution.mines.assign(result.knownMines.begin(), result.knownMines.end());
+    solution.clears.assign(result.knownClears.begin(), result.knownClears.end());
+
+    double outsideMean = 0.0;
+    for (uint32_t chainIdx : chains)
+        outsideMean += outsideMines[chainIdx];
+    outsideMean /= chains.size();
+    solution.outsideMineProb = outsideMineCells > 0 ? outsideMean / outsideMineCells : 0.0;
+
+    const double n = options.samplesPerChain;
+    const double m = chains.size();
+    double maxRHat = m < 2 ? std::numeric_limits<double>::quiet_NaN() : 1.0;
+    double probError = 0.0;
+    for (uint32_t cell = 0; cell < problem.numCells; cell++)
+    {
+        // between and within chain variances of the mine indicator of the cell
+        double mean = 0.0;
+        double within = 0.0;
+        for (uint32_t chainIdx : chains)
+        {
+            const double chainMean = hits[chainIdx][cell] / n;
+            mean += chainMean;
+            within += chainMean * (1.0 - chainMean) * n / std::max(n - 1.0, 1.0);
+        }
+        mean /= m;
+        within /= m;
+        double between = 0.0;
+        for (uint32_t chainIdx : chains)
+        {
+            const double chainMean = hits[chainIdx][cell] / n;
+            between += (chainMean - mean) * (chainMean - mean);
+        }
+        solution.mineProbs[cell].prob = mean;
+
+        if (m < 2)
+        {
+            probError = std::max(probError, std::sqrt(mean * (1.0 - mean) / n));
+            continue;
+        }
+        between /= m - 1.0;
+        probError = std::max(probError, std::sqrt(between / m));
+        if (within > 0.0)
+        {
+            const double pooled = (n - 1.0) / n * within + between;
+            maxRHat = std::max(maxRHat, std::sqrt(pooled / within));
+        }
+        else if (between > 0.0)
+            maxRHat = std::numeric_limits<double>::infinity();
+    }
+    solution.probError = probError;
+
+    if (diagnostics)
+    {
+        diagnostics->maxRHat = maxRHat;
+        diagnostics->numChains = chains.size();
+        uint64_t totalProposals = 0;
+        uint64_t totalAccepted = 0;
+        for (uint32_t chainIdx : chains)
+        {
+            totalProposals += proposals[chainIdx];
+            totalAccepted += accepted[chainIdx];
+        }
+        diagnostics->acceptanceRate = totalProposals == 0
+            ? 1.0
+            : static_cast<double>(totalAccepted) / static_cast<double>(totalProposals);
+    }
+    return {solution};
+}
+
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <concepts>
 #include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "../board_image.h"
 #include "../types.h"
+#include "../util/big_uint.h"
 
 struct SolutionInfo
 {
@@ -17,11 +20,16 @@ struct SolutionInfo
 
     std::vector<Point> mines;
     std::vector<Point> clears;
-    uint32_t numValidSolutions;
+    // 0 if the solution isn't exact
+    BigUint numValidSolutions;
     std::vector<MineProb> mineProbs;
     double outsideMineProb;
+    // false if some of the probabilities were estimated by sampling instead of enumerated
+    bool exact = true;
+    // rough standard error of the estimated probabilities, 0 if exact
+    double probError = 0.0;
 
-    void initMineProbs(const std::vector<Point>& points)
+    void initMineProbs(std::span<const Point> points)
     {
         mineProbs.reserve(points.size());
         for (Point pt : points)
@@ -50,3 +58,40 @@ struct SolutionInfo
 };
 
 using Solver = std::function<std::optional<SolutionInfo>(const BoardImage& image)>;
+
+// anything that can be called like a Solver
+// templates taking one are called directly instead of through a std::function
+template<typename T>
+concept SolverFunction = requires(T& solver, const BoardImage& image) {
+    { solver(image) } -> std::convertible_to<std::optional<SolutionInfo>>;
+};
+
+// a solver that takes many positions at once, so its setup and scratch memory are reused
+// between them instead of being built again for every position
+template<typename T>
+concept BatchSolver = requires(
+    T& solver, std::span<const BoardImage> images, std::span<SolutionInfo> solutions) {
+    { solver.solveBatch(images, solutions) } -> std::same_as<uint32_t>;
+};
+
+// solves images[i] into solutions[i], positions that can't be solved get an empty SolutionInfo
+// returns the number of positions that were solved
+template<typename T>
+    requires SolverFunction<T> || BatchSolver<T>
+uint32_t solveBatch(
+    T&& solver, std::span<const BoardImage> images, std::span<SolutionInfo> solutions)
+{
+    if constexpr (BatchSolver<T>)
+        return solver.solveBatch(images, solutions);
+    else
+    {
+        uint32_t numSolved = 0;
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            std::optional<SolutionInfo> solution = solver(images[i]);
+            numSolved += solution.has_value();
+            solutions[i] = solution ? std::move(solution.value()) : SolutionInfo{};
+        }
+        return numSolved;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../util/grid_index.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace solvers
+{
+
+// Scratch memory for solving positions one after another
+// Everything a solve allocates comes from a monotonic arena over a single buffer, and reset()
+// takes all of it back at once before the next solve. A solve that outgrows the buffer spills
+// over to the heap, and the next reset() grows the buffer to fit, so once the largest position
+// has been seen, the arena doesn't allocate from the heap anymore
+// Memory that outlives reset() doesn't come from the arena: the SolutionInfo being written
+// and its BigUint limbs, component cache entries, and the per thread state of multithreaded
+// solves all use the heap directly
+// Not thread safe, use one context per thread
+class SolverContext
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    SolverContext(size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    SolverContext(const SolverContext&) = delete;
+    SolverContext& operator=(const SolverContext&) = delete;
+
+    // frees everything allocated from resource() since the last reset()
+    // nothing allocated from resource() may be used after this
+    void reset();
+    std::pmr::memory_resource* resource();
+    // index of the cells of the board, kept across reset() so its grid is only allocated again
+    // when the size of the board changes
+    GridIndex& gridIndex();
+
+    // heap allocations made by the arena, the spills past its buffer and the buffer growths
+    // stops increasing once the buffer fits every position being solved
+    // allocations that don't go through resource() aren't counted
+    uint64_t heapAllocations() const;
+    size_t bufferSize() const;
+
+private:
+    // the heap, counting how often it is used
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        uint64_t allocations = 0;
+        // bytes allocated since the last reset()
+        size_t bytes = 0;
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) override
+        {
+            allocations++;
+            bytes += size;
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* ptr, size_t size, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    void allocateBuffer(size_t bufferSize);
+
+    CountingResource m_Heap;
+    std::unique_ptr<std::byte[]> m_Buffer;
+    size_t m_BufferSize = 0;
+    std::optional<std::pmr::monotonic_buffer_resource> m_Arena;
+    GridIndex m_GridIndex;
+};
+
+inline SolverContext::SolverContext(size_t bufferSize)
+{
+    allocateBuffer(bufferSize);
+}
+
+inline void SolverContext::allocateBuffer(size_t bufferSize)
+{
+    m_Arena.reset();
+    m_Heap.allocations++;
+    m_Buffer = std::make_unique<std::byte[]>(bufferSize);
+    m_BufferSize = bufferSize;
+    m_Arena.emplace(m_Buffer.get(), m_BufferSize, &m_Heap);
+}
+
+inline void SolverContext::reset()
+{
+    m_Arena->release();
+    // the last solve didn't fit, make room for it and then some
+    if (m_Heap.bytes > 0)
+        allocateBuffer(std::bit_ceil(2 * (m_BufferSize + m_Heap.bytes)));
+    m_Heap.bytes = 0;
+}
+
+inline std::pmr::memory_resource* SolverContext::resource()
+{
+    return &m_Arena.value();
+}
+
+inline GridIndex& SolverContext::gridIndex()
+{
+    return m_GridIndex;
+}
+
+inline uint64_t SolverContext::heapAllocations() const
+{
+    return m_Heap.allocations;
+}
+
+inline size_t SolverContext::bufferSize() const
+{
+    return m_BufferSize;
+}
+
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "../board_image.h"
+#include "../util/grid_index.h"
+#include "basic_optimized.h"
+#include "components.h"
+#include "mine_counts.h"
+#include "solution_info.h"
+
+#include <map>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace solvers
+{
+
+// Keeps the constraints and components of a game between moves
+// Revealing cells only breaks up the components whose constraints changed, and solve()
+// only regroups and solves those constraints again, every other component keeps its result
+// Only combining the components into probabilities still looks at the whole frontier,
+// since the number of mines left couples all of them
+class SolverSession
+{
+public:
+    SolverSession(const BoardData& data);
+
+    // cells cleared by a move, with their numbers and uncleared neighbors after the move
+    void reveal(std::span<const CellInfo> cells);
+
+    // same results as basic_optimized::solve on the current board
+    // components are combined in the order they were grouped, so cells can be listed in a
+    // different order than basic_optimized::solve lists them
+    std::optional<SolutionInfo> solve();
+
+    // components solved and reused by the last call to solve()
+    uint32_t componentsSolved() const;
+    uint32_t componentsReused() const;
+
+private:
+    static constexpr uint32_t NO_COMPONENT = UINT32_MAX;
+
+    struct Constraint
+    {
+        // cell indices of the uncleared neighbors
+        std::vector<uint32_t> cells;
+        uint32_t sum;
+        uint32_t component;
+    };
+
+    struct Component
+    {
+        // cell indices of the numbered cells
+        std::vector<uint32_t> constraints;
+        // empty if the component was too large to enumerate
+        std::optional<basic_optimized::FrontierSolution> solution;
+    };
+
+    uint32_t cellIndex(Point pt) const;
+    Point cellLocation(uint32_t idx) const;
+    void invalidate(uint32_t location);
+    void solveComponent(uint32_t location);
+
+    BoardData m_Data;
+    std::vector<bool> m_Cleared;
+    uint32_t m_NumCleared = 0;
+
+    // constraint of each numbered cell with uncleared neighbors, by cell index
+    std::unordered_map<uint32_t, Constraint> m_Constraints;
+    // cell index -> cell indices of the constraints containing it
+    std::vector<std::vector<uint32_t>> m_CellConstraints;
+
+    // ordered by id, so components are combined in the order they were grouped
+    std::map<uint32_t, Component> m_Components;
+    uint32_t m_NextComponent = 0;
+    // constraints that aren't in a component, because they are new or their component changed
+    std::vector<uint32_t> m_Ungrouped;
+    // cell index -> index of the cell in the component being grouped
+    GridIndex m_FrontierIndices;
+
+    uint32_t m_ComponentsSolved = 0;
+    uint32_t m_ComponentsReused = 0;
+};
+
+inline SolverSession::SolverSession(const BoardData& data)
+    : m_Data(data),
+      m_Cleared(data.width * data.height),
+      m_CellConstraints(data.width * data.height),
+      m_FrontierIndices(data.width, data.height)
+{
+}
+
+inline uint32_t SolverSession::cellIndex(Point pt) const
+{
+    return pt.x + pt.y * m_Data.width;
+}
+
+inline Point SolverSession::cellLocation(uint32_t idx) const
+{
+    return {idx % m_Data.width, idx / m_Data.width};
+}
+
+// drops the component of a constraint, all of its constraints have to be grouped again
+inline void SolverSession::invalidate(uint32_t location)
+{
+    auto constraintIt = m_Constraints.find(location);
+    if (constraintIt == m_Constraints.end() || constraintIt->second.component == NO_COMPONENT)
+        return;
+
+    auto componentIt = m_Components.find(constraintIt->second.component);
+    for (uint32_t other : componentIt->second.constraints)
+    {
+        auto otherIt = m_Constraints.find(other);
+        if (otherIt == m_Constraints.end())
+            continue;
+        otherIt->second.component = NO_COMPONENT;
+        m_Ungrouped.push_back(other);
+    }
+    m_Components.erase(componentIt);
+}
+
+inline void SolverSession::reveal(std::span<const CellInfo> cells)
+{
+    for (const CellInfo& info : cells)
+    {
+        const uint32_t idx = cellIndex(info.location);
+        if (m_Cleared[idx])
+            continue;
+        m_Cleared[idx] = true;
+        m_NumCleared++;
+
+        // the cell is now known to be clear, so it only drops out of its constraints
+        for (uint32_t location : m_CellConstraints[idx])
+        {
+            invalidate(location);
+            Constraint& constraint = m_Constraints.at(location);
+            std::erase(constraint.cells, idx);
+            // unsatisfiable constraints are kept so the solution reflects them
+            if (constraint.cells.empty() && constraint.sum == 0)
+                m_Constraints.erase(location);
+        }
+        m_CellConstraints[idx].clear();
+    }
+
+    for (const CellInfo& info : cells)
+    {
+        const uint32_t idx = cellIndex(info.location);
+        if (info.adjacentMines == 0 || m_Constraints.count(idx) > 0)
+            continue;
+
+        Constraint constraint = {{}, info.adjacentMines, NO_COMPONENT};
+        for (Point neighbor : info.unclearedNeighbors)
+        {
+            const uint32_t neighborIdx = cellIndex(neighbor);
+            if (m_Cleared[neighborIdx])
+                continue;
+            // the new constraint joins the components of all constraints it shares cells with
+            for (uint32_t location : m_CellConstraints[neighborIdx])
+                invalidate(location);
+            constraint.cells.push_back(neighborIdx);
+            m_CellConstraints[neighborIdx].push_back(idx);
+        }
+        if (constraint.cells.empty() && constraint.sum == 0)
+            continue;
+        m_Constraints.insert({idx, std::move(constraint)});
+        m_Ungrouped.push_back(idx);
+    }
+}
+
+// groups every constraint connected to location into a new component and solves it
+inline void SolverSession::solveComponent(uint32_t location)
+{
+    const uint32_t id = m_NextComponent++;
+    Component& component = m_Components[id];
+
+    // each cell of the component is assigned an index
+    m_FrontierIndices.reset(m_Data.width, m_Data.height);
+    std::vector<Point> frontier;
+    std::vector<components::FrontierConstraint> frontierConstraints;
+
+    std::vector<uint32_t> stack = {location};
+    m_Constraints.at(location).component = id;
+    while (!stack.empty())
+    {
+        uint32_t curr = stack.back();
+        stack.pop_back();
+        component.constraints.push_back(curr);
+
+        const Constraint& constraint = m_Constraints.at(curr);
+        components::FrontierConstraint frontierConstraint = {};
+        frontierConstraint.sum = constraint.sum;
+        for (uint32_t cell : constraint.cells)
+        {
+            auto [idx, inserted] = m_FrontierIndices.insert(cell, frontier.size());
+            if (inserted)
+            {
+                frontier.push_back(cellLocation(cell));
+                for (uint32_t other : m_CellConstraints[cell])
+                {
+                    Constraint& otherConstraint = m_Constraints.at(other);
+                    if (otherConstraint.component == id)
+                        continue;
+                    otherConstraint.component = id;
+                    stack.push_back(other);
+                }
+            }
+            frontierConstraint.indices.push_back(idx);
+        }
+        frontierConstraints.push_back(frontierConstraint);
+    }
+
+    component.solution = basic_optimized::solveFrontier<constraint_kernels::DEFAULT_KERNEL>(
+        frontier, frontierConstraints, 1, basic_optimized::Ordering::REVERSE_CUTHILL_MCKEE,
+        nullptr, nullptr);
+}
+
+inline std::optional<SolutionInfo> SolverSession::solve()
+{
+    m_ComponentsSolved = 0;
+    for (uint32_t location : m_Ungrouped)
+    {
+        auto it = m_Constraints.find(location);
+        if (it == m_Constraints.end() || it->second.component != NO_COMPONENT)
+            continue;
+        solveComponent(location);
+        m_ComponentsSolved++;
+    }
+    m_Ungrouped.clear();
+    m_ComponentsReused = m_Components.size() - m_ComponentsSolved;
+
+    std::vector<Point> uncleared;
+    std::vector<mine_counts::Histogram> histograms;
+    std::vector<Point> knownMines;
+    std::vector<Point> knownClears;
+    uint32_t frontierSize = 0;
+    for (const auto& [id, component] : m_Components)
+    {
+        if (!component.solution)
+            return {};
+        const basic_optimized::FrontierSolution& solution = component.solution.value();
+
+        // histogram cells index into the component's uncleared cells, offset them
+        // to index into the uncleared cells of the whole frontier
+        const uint32_t offset = uncleared.size();
+        uncleared.insert(uncleared.end(), solution.uncleared.begin(), solution.uncleared.end());
+        for (mine_counts::Histogram histogram : solution.histograms)
+        {
+            for (uint32_t& cell : histogram.cells)
+                cell += offset;
+            histograms.push_back(std::move(histogram));
+        }
+        knownMines.insert(knownMines.end(), solution.knownMines.begin(), solution.knownMines.end());
+        knownClears.insert(
+            knownClears.end(), solution.knownClears.begin(), solution.knownClears.end());
+        frontierSize += solution.uncleared.size() + solution.knownMines.size()
+            + solution.knownClears.size();
+    }
+
+    const uint32_t outsideMineCells = m_Data.width * m_Data.height - frontierSize - m_NumCleared;
+    const uint32_t availableMines = m_Data.numMines - knownMines.size();
+    SolutionInfo solution =
+        mine_counts::combine(uncleared, histograms, outsideMineCells, availableMines);
+    solution.mines.insert(solution.mines.end(), knownMines.begin(), knownMines.end());
+    solution.clears.insert(solution.clears.end(), knownClears.begin(), knownClears.end());
+    return {solution};
+}
+
+inline uint32_t SolverSession::componentsSolved() const
+{
+    return m_ComponentsSolved;
+}
+
+inline uint32_t SolverSession::componentsReused() const
+{
+    return m_ComponentsReused;
+}
+
+}
@@ -1,7 +1,6 @@
 #include "test_suite.h"
 #include "raw_test_data.h"
 
-#include <chrono>
 #include <unordered_set>
 
 TestPosition TestPosition::fromImage(const BoardImage& image, const SolutionInfo& solution)
@@ -18,39 +17,52 @@ TestPosition TestPosition::fromImage(const BoardImage& image, const SolutionInfo
     return result;
 }
 
-void run_test_suite(TestSuite suite, Solver solver, bool verbose)
+const std::vector<TestPosition>& getPositions(TestSuite suite)
 {
-    const std::vector<TestPosition>& positions = [&]()
+    switch (suite)
     {
-        switch (suite)
-        {
-            case TestSuite::EASY:
-                return test_cases::easyCases;
-            case TestSuite::MEDIUM:
-                return test_cases::mediumCases;
-            case TestSuite::HARD:
-                return test_cases::hardCases;
-            default:
-                throw std::runtime_error("Invalid test case");
-        }
-    }();
+        case TestSuite::EASY:
+            return test_cases::easyCases;
+        case TestSuite::MEDIUM:
+            return test_cases::mediumCases;
+        case TestSuite::HARD:
+            return test_cases::hardCases;
+        default:
+            throw std::runtime_error("Invalid test case");
+    }
+}
 
-    auto t1 = std::chrono::steady_clock::now();
+BoardImage buildImage(const TestPosition& pos)
+{
+    BoardImageBuilder builder(pos.data);
+    for (const auto& [location, adjacentMines] : pos.clearedCells)
+        builder.addClearedCell(location, adjacentMines);
+    return builder.build();
+}
+
+std::vector<BoardImage> buildTestSuiteImages(TestSuite suite)
+{
+    std::vector<BoardImage> images;
+    for (const auto& pos : getPositions(suite))
+        images.push_back(buildImage(pos));
+    return images;
+}
+
+void reportTestSuite(
+    TestSuite suite, std::span<const SolutionInfo> solutions, double seconds, bool verbose)
+{
+    const std::vector<TestPosition>& positions = getPositions(suite);
 
     uint32_t numPassed = 0;
     uint32_t numFailed = 0;
 
-    for (const auto& pos : positions)
+    for (size_t i = 0; i < positions.size(); i++)
     {
-        BoardImageBuilder builder(pos.data);
-        for (const auto& [location, adjacentMines] : pos.clearedCells)
-            builder.addClearedCell(location, adjacentMines);
-
-        BoardImage image = builder.build();
-        SolutionInfo solution = solver(image).value();
+        const TestPosition& pos = positions[i];
+        const SolutionInfo& solution = solutions[i];
 
         if (verbose)
-            std::cout << image.renderSolution(solution) << std::endl;
+            std::cout << buildImage(pos).renderSolution(solution) << std::endl;
 
         bool passed = true;
 
@@ -120,8 +132,6 @@ void run_test_suite(TestSuite suite, Solver solver, bool verbose)
         numFailed += !passed;
     }
 
-    auto t2 = std::chrono::steady_clock::now();
-    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1).count();
     switch (suite)
     {
         case TestSuite::EASY:
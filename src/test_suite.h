@@ -3,6 +3,10 @@
 #include "board_image.h"
 #include "solvers/solution_info.h"
 
+#include <chrono>
+#include <span>
+#include <vector>
+
 struct TestPosition
 {
     BoardData data;
@@ -19,4 +23,41 @@ enum class TestSuite
     HARD
 };
 
-void run_test_suite(TestSuite suite, Solver solver, bool verbose = false);
+std::vector<BoardImage> buildTestSuiteImages(TestSuite suite);
+// checks solutions[i] against the expected solution of the i-th position and prints the results
+void reportTestSuite(
+    TestSuite suite, std::span<const SolutionInfo> solutions, double seconds, bool verbose);
+
+// solvers are taken by template, so they are called directly and get the whole suite as a batch
+template<typename T>
+    requires SolverFunction<T> || BatchSolver<T>
+void run_test_suite(TestSuite suite, T&& solver, bool verbose = false)
+{
+    const std::vector<BoardImage> images = buildTestSuiteImages(suite);
+    std::vector<SolutionInfo> solutions(images.size());
+
+    auto t1 = std::chrono::steady_clock::now();
+    solveBatch(solver, images, solutions);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1).count();
+    reportTestSuite(suite, solutions, seconds, verbose);
+}
+
+// solves every position in the suite `iterations` times without checking the results
+// returns the average number of seconds to solve the whole suite once
+template<typename T>
+    requires SolverFunction<T> || BatchSolver<T>
+double benchmark_test_suite(TestSuite suite, T&& solver, uint32_t iterations)
+{
+    const std::vector<BoardImage> images = buildTestSuiteImages(suite);
+    std::vector<SolutionInfo> solutions(images.size());
+
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+        solveBatch(solver, images, solutions);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1).count();
+    return seconds / iterations;
+}
@@ -67,7 +67,7 @@ std::string getTestPosStr(const TestPosition& testPos)
         first = false;
     }
     result += "},\n";
-    result += "            " + std::to_string(testPos.solutionInfo.numValidSolutions);
+    result += "            " + testPos.solutionInfo.numValidSolutions.toString();
     result += ",\n            {";
     first = true;
     for (const auto& mineProb : testPos.solutionInfo.mineProbs)
@@ -133,8 +133,7 @@ void generateTestSuite()
         if (!solution.has_value())
         {
             // std::cout << image;
-            std::cout << "Too many unsolved nodes in the solution, skipping (needs bigint fr)"
-                      << std::endl;
+            std::cout << "Too many unsolved nodes in the solution, skipping" << std::endl;
             i--;
             continue;
         }
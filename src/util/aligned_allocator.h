@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+// allocator for std::vector with over-aligned storage, e.g. for aligned SIMD loads
+// the storage comes from a memory resource, the default resource unless one is given
+template<typename T, size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource(resource)
+    {
+    }
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& other)
+        : resource(other.resource)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(resource->allocate(n * sizeof(T), Alignment));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        resource->deallocate(ptr, n * sizeof(T), Alignment);
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>& other) const
+    {
+        return *resource == *other.resource;
+    }
+
+    std::pmr::memory_resource* resource;
+};
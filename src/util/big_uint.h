@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// arbitrary precision unsigned integer
+// only supports what is needed to count solutions: adding and multiplying
+class BigUint
+{
+public:
+    BigUint() = default;
+
+    BigUint(uint64_t value)
+    {
+        while (value > 0)
+        {
+            m_Limbs.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    BigUint& operator+=(const BigUint& other)
+    {
+        if (other.m_Limbs.size() > m_Limbs.size())
+            m_Limbs.resize(other.m_Limbs.size());
+
+        uint64_t carry = 0;
+        for (size_t i = 0; i < m_Limbs.size(); i++)
+        {
+            uint64_t sum = carry + m_Limbs[i];
+            if (i < other.m_Limbs.size())
+                sum += other.m_Limbs[i];
+            m_Limbs[i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        if (carry > 0)
+            m_Limbs.push_back(static_cast<uint32_t>(carry));
+        return *this;
+    }
+
+    // reuses the limbs that are already allocated
+    BigUint& operator=(uint64_t value)
+    {
+        m_Limbs.clear();
+        while (value > 0)
+        {
+            m_Limbs.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+        return *this;
+    }
+
+    // in place, so it only allocates when the number grows past the allocated limbs
+    BigUint& operator*=(uint64_t value)
+    {
+        unsigned __int128 carry = 0;
+        for (uint32_t& limb : m_Limbs)
+        {
+            unsigned __int128 product = static_cast<unsigned __int128>(limb) * value + carry;
+            limb = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        while (carry > 0)
+        {
+            m_Limbs.push_back(static_cast<uint32_t>(carry));
+            carry >>= 32;
+        }
+        trim();
+        return *this;
+    }
+
+    bool operator==(const BigUint& other) const = default;
+
+    bool isZero() const
+    {
+        return m_Limbs.empty();
+    }
+
+    double toDouble() const
+    {
+        double result = 0.0;
+        for (size_t i = m_Limbs.size(); i-- > 0;)
+            result = result * 4294967296.0 + m_Limbs[i];
+        return result;
+    }
+
+    std::string toString() const
+    {
+        if (isZero())
+            return "0";
+
+        std::string result;
+        BigUint value = *this;
+        while (!value.isZero())
+        {
+            // divide by 10^9 and emit the remainder as 9 digits
+            uint64_t remainder = 0;
+            for (size_t i = value.m_Limbs.size(); i-- > 0;)
+            {
+                uint64_t curr = (remainder << 32) | value.m_Limbs[i];
+                value.m_Limbs[i] = static_cast<uint32_t>(curr / 1000000000);
+                remainder = curr % 1000000000;
+            }
+            value.trim();
+
+            for (int digit = 0; digit < 9 && (remainder > 0 || !value.isZero()); digit++)
+            {
+                result.push_back(static_cast<char>('0' + remainder % 10));
+                remainder /= 10;
+            }
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    void trim()
+    {
+        while (!m_Limbs.empty() && m_Limbs.back() == 0)
+            m_Limbs.pop_back();
+    }
+
+    // little endian, without leading zero limbs
+    std::vector<uint32_t> m_Limbs;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const BigUint& value)
+{
+    os << value.toString();
+    return os;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../types.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Maps the cells of a board to indices with one entry per cell, at x + y * width
+// Every entry is stamped with the epoch it was written in, and entries from older epochs
+// count as empty, so reset() only has to start a new epoch instead of clearing the grid
+class GridIndex
+{
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    GridIndex() = default;
+    GridIndex(uint32_t width, uint32_t height);
+
+    // removes every entry, and resizes the grid if the board size changed
+    void reset(uint32_t width, uint32_t height);
+
+    // NONE if the cell has no index
+    uint32_t find(Point pt) const;
+    uint32_t find(uint32_t cell) const;
+    // the index of the cell, and whether it was inserted with value because it had none
+    std::pair<uint32_t, bool> insert(Point pt, uint32_t value);
+    std::pair<uint32_t, bool> insert(uint32_t cell, uint32_t value);
+
+private:
+    struct Entry
+    {
+        uint32_t epoch;
+        uint32_t value;
+    };
+
+    std::vector<Entry> m_Entries;
+    uint32_t m_Width = 0;
+    // entries are only valid if they have the current epoch, 0 is never current
+    uint32_t m_Epoch = 1;
+};
+
+inline GridIndex::GridIndex(uint32_t width, uint32_t height)
+{
+    reset(width, height);
+}
+
+inline void GridIndex::reset(uint32_t width, uint32_t height)
+{
+    if (m_Width != width || m_Entries.size() != static_cast<size_t>(width) * height)
+    {
+        m_Width = width;
+        m_Entries.assign(static_cast<size_t>(width) * height, {0, 0});
+        m_Epoch = 1;
+        return;
+    }
+
+    // the epoch only wraps around after 2^32 resets, and then the grid is cleared once
+    if (++m_Epoch == 0)
+    {
+        m_Entries.assign(m_Entries.size(), {0, 0});
+        m_Epoch = 1;
+    }
+}
+
+inline uint32_t GridIndex::find(Point pt) const
+{
+    return find(pt.x + pt.y * m_Width);
+}
+
+inline uint32_t GridIndex::find(uint32_t cell) const
+{
+    const Entry& entry = m_Entries[cell];
+    return entry.epoch == m_Epoch ? entry.value : NONE;
+}
+
+inline std::pair<uint32_t, bool> GridIndex::insert(Point pt, uint32_t value)
+{
+    return insert(pt.x + pt.y * m_Width, value);
+}
+
+inline std::pair<uint32_t, bool> GridIndex::insert(uint32_t cell, uint32_t value)
+{
+    Entry& entry = m_Entries[cell];
+    if (entry.epoch == m_Epoch)
+        return {entry.value, false};
+    entry = {m_Epoch, value};
+    return {value, true};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Runs func(threadIdx, taskIdx) for every task in [0, numTasks) on numThreads threads
+// idle threads claim the next unprocessed task, so uneven tasks still balance out
+// each thread gets its own threadIdx, so it can accumulate into thread local state
+template<typename Func>
+void parallelFor(uint64_t numTasks, uint32_t numThreads, Func&& func)
+{
+    std::atomic<uint64_t> nextTask = 0;
+    const auto worker = [&](uint32_t threadIdx)
+    {
+        uint64_t task;
+        while ((task = nextTask.fetch_add(1, std::memory_order_relaxed)) < numTasks)
+            func(threadIdx, task);
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < numThreads; i++)
+        threads.emplace_back(worker, i);
+    worker(0);
+    for (auto& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// double with a separate 64 bit exponent, value = mantissa * 2^exponent
+// used for solution weights and counts that would over or underflow a plain double
+// scaling by powers of 2 is exact, so results match plain doubles whenever those don't overflow
+class ScaledDouble
+{
+public:
+    ScaledDouble() = default;
+
+    ScaledDouble(double value)
+    {
+        int exponent;
+        m_Mantissa = std::frexp(value, &exponent);
+        m_Exponent = exponent;
+    }
+
+    ScaledDouble operator*(const ScaledDouble& other) const
+    {
+        return ScaledDouble(m_Mantissa * other.m_Mantissa, m_Exponent + other.m_Exponent);
+    }
+
+    ScaledDouble operator/(const ScaledDouble& other) const
+    {
+        return ScaledDouble(m_Mantissa / other.m_Mantissa, m_Exponent - other.m_Exponent);
+    }
+
+    ScaledDouble operator+(const ScaledDouble& other) const
+    {
+        if (m_Mantissa == 0.0)
+            return other;
+        if (other.m_Mantissa == 0.0)
+            return *this;
+
+        const ScaledDouble& larger = m_Exponent >= other.m_Exponent ? *this : other;
+        const ScaledDouble& smaller = m_Exponent >= other.m_Exponent ? other : *this;
+        int64_t shift = larger.m_Exponent - smaller.m_Exponent;
+        // the smaller value is too small to change the sum
+        if (shift > 64)
+            return larger;
+        return ScaledDouble(
+            larger.m_Mantissa + std::ldexp(smaller.m_Mantissa, -static_cast<int>(shift)),
+            larger.m_Exponent);
+    }
+
+    ScaledDouble& operator*=(const ScaledDouble& other)
+    {
+        return *this = *this * other;
+    }
+
+    ScaledDouble& operator/=(const ScaledDouble& other)
+    {
+        return *this = *this / other;
+    }
+
+    ScaledDouble& operator+=(const ScaledDouble& other)
+    {
+        return *this = *this + other;
+    }
+
+    double toDouble() const
+    {
+        if (m_Exponent > 2048)
+            return m_Mantissa * INFINITY;
+        if (m_Exponent < -2048)
+            return 0.0;
+        return std::ldexp(m_Mantissa, static_cast<int>(m_Exponent));
+    }
+
+private:
+    ScaledDouble(double mantissa, int64_t exponent)
+    {
+        int shift;
+        m_Mantissa = std::frexp(mantissa, &shift);
+        m_Exponent = m_Mantissa == 0.0 ? 0 : exponent + shift;
+    }
+
+    // 0 or in [0.5, 1)
+    double m_Mantissa = 0.0;
+    int64_t m_Exponent = 0;
+};